@@ -0,0 +1,167 @@
+/**
+ * @file anomaly.cpp
+ * @author Julia
+ * @brief Implements an online detector for unusual unit prices.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include "unit.h"
+#include "utils.h"
+#include "interner.h"
+#include "shopping_list.h"
+#include "anomaly.h"
+
+/// The smallest deviation in log price that is flagged, i.e. a 50% change. Keeps items whose price
+/// has never changed from flagging every cent of movement.
+double const MIN_LOG_DEVIATION = 0.4054651081081644;
+/// The number of prices in a row flagged on the same side after which they are taken as the item's
+/// new price.
+uint32_t const LEVEL_SHIFT_RUN_LENGTH = 3;
+
+/**
+ * @brief Adds a log price to the statistics with Welford's method.
+ * 
+ * @param logPrice The log unit price.
+ */
+void PriceAnomalyDetector::RunningStats::add(double logPrice) {
+    count++;
+    
+    double delta = logPrice - mean;
+    
+    mean += delta / count;
+    m2 += delta * (logPrice - mean);
+}
+
+/**
+ * @brief Creates a detector.
+ * 
+ * @param preferredUnit The unit to price weighed items in.
+ * @param threshold The number of standard deviations beyond which a price is flagged.
+ * @param minObservations The number of observations required before an item can be flagged. At
+ * least 2, since a single observation has no spread.
+ */
+PriceAnomalyDetector::PriceAnomalyDetector(Unit preferredUnit, double threshold, uint32_t minObservations) :
+    preferredUnit(preferredUnit),
+    threshold(threshold),
+    minObservations(std::max<uint32_t>(minObservations, 2)) {}
+
+/**
+ * @brief Checks an item against its history and then adds it to the history.
+ * 
+ * Prices are compared on a log scale so that a price ten times too high is as unusual as one ten
+ * times too low. Statistics are updated with Welford's method in constant time. Flagged prices are
+ * clamped to the edge of the normal range before they are added, so one bad line barely widens
+ * the range. When several prices in a row are flagged on the same side, the price has changed for
+ * good, so the statistics start again from those prices.
+ * 
+ * @param shoppingListItem The shopping list item.
+ * @param lineNumber The line number of the item.
+ * @return An optional containing the anomaly if the price was flagged.
+ */
+std::optional<PriceAnomaly> PriceAnomalyDetector::observe(const ShoppingListItem &shoppingListItem, size_t lineNumber) {
+    double unitPrice = getShoppingListItemUnitPrice(shoppingListItem, preferredUnit);
+    
+    if (unitPrice <= 0) {
+        // Free items have no meaningful log price.
+        return std::nullopt;
+    }
+    
+    uint32_t id = names.intern(shoppingListItem.name);
+    
+    if (id == stats.size()) {
+        stats.emplace_back();
+    }
+    
+    ItemStats &itemStats = stats[id];
+    RunningStats &priceStats = itemStats.stats;
+    double logPrice = std::log(unitPrice);
+    
+    if (priceStats.count < minObservations) {
+        priceStats.add(logPrice);
+        return std::nullopt;
+    }
+    
+    double stdDev = std::sqrt(priceStats.m2 / (priceStats.count - 1));
+    double maxDeviation = std::max(threshold * stdDev, MIN_LOG_DEVIATION);
+    double deviation = std::abs(logPrice - priceStats.mean);
+    
+    if (deviation <= maxDeviation) {
+        priceStats.add(logPrice);
+        itemStats.flaggedRun = RunningStats();
+        return std::nullopt;
+    }
+    
+    PriceAnomaly anomaly = PriceAnomaly {
+        .lineNumber = lineNumber,
+        .name = shoppingListItem.name,
+        .unitPrice = unitPrice,
+        .expectedUnitPrice = std::exp(priceStats.mean),
+        .zScore = stdDev > 0 ? deviation / stdDev : INFINITY,
+    };
+    bool isHigh = logPrice > priceStats.mean;
+    
+    if (itemStats.flaggedRun.count > 0 && itemStats.isFlaggedRunHigh != isHigh) {
+        itemStats.flaggedRun = RunningStats();
+    }
+    
+    itemStats.isFlaggedRunHigh = isHigh;
+    itemStats.flaggedRun.add(logPrice);
+    
+    if (itemStats.flaggedRun.count >= LEVEL_SHIFT_RUN_LENGTH) {
+        priceStats = itemStats.flaggedRun;
+        itemStats.flaggedRun = RunningStats();
+    } else {
+        priceStats.add(priceStats.mean + (isHigh ? maxDeviation : -maxDeviation));
+    }
+    
+    return anomaly;
+}
+
+/**
+ * @brief Checks every item in a shopping list file.
+ * 
+ * @param filePath The path to the shopping list file.
+ * @return The flagged lines in the order they appear.
+ */
+std::vector<PriceAnomaly> PriceAnomalyDetector::observeFile(const std::string &filePath) {
+    std::ifstream file(filePath);
+    
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open \"" + filePath + "\"");
+    }
+    
+    std::vector<PriceAnomaly> anomalies;
+    size_t lineNumber = 0;
+    
+    for (std::string line; getline(file, line);) {
+        lineNumber++;
+        
+        // Skip empty lines and comments.
+        if (line.empty() || startsWith(line, "//")) {
+            continue;
+        }
+        
+        try {
+            std::optional<PriceAnomaly> anomaly = observe(parseShoppingListItemStr(line), lineNumber);
+            
+            if (anomaly.has_value()) {
+                anomalies.push_back(std::move(*anomaly));
+            }
+        } catch (std::runtime_error& e) {
+            // Lines that fail to parse have no price to check.
+        }
+    }
+    
+    return anomalies;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file anomaly.h
+ * @author Julia
+ * @brief Declares an online detector for unusual unit prices.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef ANOMALY_H
+#define ANOMALY_H
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "unit.h"
+#include "interner.h"
+#include "shopping_list.h"
+
+/// A line whose unit price deviates sharply from the history of its item.
+struct PriceAnomaly {
+    /// The line number in the file, starting at 1.
+    size_t lineNumber;
+    /// The name of the item.
+    std::string name;
+    /// The unit price of the line in cents.
+    double unitPrice;
+    /// The typical unit price of the item in cents.
+    double expectedUnitPrice;
+    /// The number of standard deviations the price is from the typical price.
+    double zScore;
+};
+
+/// Flags unit prices that deviate sharply from each item's running statistics.
+class PriceAnomalyDetector {
+public:
+    PriceAnomalyDetector(Unit preferredUnit = Unit::Pound, double threshold = 3.5, uint32_t minObservations = 5);
+    
+    std::optional<PriceAnomaly> observe(const ShoppingListItem &shoppingListItem, size_t lineNumber);
+    std::vector<PriceAnomaly> observeFile(const std::string &filePath);
+
+private:
+    /// Running mean and variance of the log unit price of an item.
+    struct RunningStats {
+        /// The number of observations.
+        uint32_t count = 0;
+        /// The mean of the log unit price.
+        double mean = 0;
+        /// The sum of squared differences from the mean.
+        double m2 = 0;
+        
+        void add(double logPrice);
+    };
+    
+    /// The statistics of an item, and of its latest run of prices flagged on the same side.
+    struct ItemStats {
+        /// The statistics of the prices, with flagged prices clamped to the edge of the normal range.
+        RunningStats stats;
+        /// The statistics of the flagged prices since the last normal one. Replaces the statistics
+        /// once it is long enough, since the price has moved to a new level.
+        RunningStats flaggedRun;
+        /// Whether the flagged run is above the mean rather than below it.
+        bool isFlaggedRunHigh = false;
+    };
+    
+    /// The unit weighed items are priced in.
+    Unit preferredUnit;
+    /// The number of standard deviations beyond which a price is flagged.
+    double threshold;
+    /// The number of observations required before an item can be flagged.
+    uint32_t minObservations;
+    /// The item names.
+    NameInterner names;
+    /// The statistics by name id.
+    std::vector<ItemStats> stats;
+};
+
+#endif
@@ -0,0 +1,699 @@
+/**
+ * @file archive.cpp
+ * @author Julia
+ * @brief Implements an archive of shopping lists that stores repeated content once.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "unit.h"
+#include "utils.h"
+#include "interner.h"
+#include "binary_io.h"
+#include "shopping_list.h"
+#include "item_filter.h"
+#include "buffered_writer.h"
+#include "archive.h"
+
+/// Identifies serialized archives.
+uint32_t const LIST_ARCHIVE_MAGIC = 0x3252414c; // "LAR2"
+/// Identifies serialized archives from before zone maps were stored.
+uint32_t const LIST_ARCHIVE_V1_MAGIC = 0x3152414c; // "LAR1"
+/// Chunks are not cut before they reach this many bytes.
+size_t const MIN_CHUNK_SIZE = 256;
+/// Chunks are always cut once they reach this many bytes.
+size_t const MAX_CHUNK_SIZE = 16384;
+/// The number of top hash bits that must be zero at a line break to cut a chunk. About one in 16
+/// line breaks is a boundary.
+int const BOUNDARY_BITS = 4;
+
+/**
+ * @brief Builds the table of random values for the rolling hash.
+ * 
+ * @return The table, one value per byte.
+ */
+constexpr std::array<uint64_t, 256> makeGearTable() {
+    std::array<uint64_t, 256> table = {};
+    uint64_t state = 0x243f6a8885a308d3ULL;
+    
+    for (size_t i = 0; i < table.size(); ++i) {
+        // splitmix64
+        state += 0x9e3779b97f4a7c15ULL;
+        
+        uint64_t z = state;
+        
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        table[i] = z ^ (z >> 31);
+    }
+    
+    return table;
+}
+
+/// Random values for the rolling hash, one per byte.
+constexpr std::array<uint64_t, 256> GEAR_TABLE = makeGearTable();
+
+/**
+ * @brief Splits content into chunks at content-defined line boundaries.
+ * 
+ * A gear hash rolls over the bytes; each shift pushes the oldest byte out, so the top bits depend
+ * only on the last 64 bytes. A chunk ends at a line break where the top bits are zero, so a
+ * boundary depends only on the line before it, and an edit only changes the chunks around it.
+ * 
+ * @param content The content.
+ * @return Views of the chunks, in order. Every chunk but the last ends with a line break.
+ */
+std::vector<std::string_view> splitContentDefinedChunks(const std::string_view &content) {
+    std::vector<std::string_view> result;
+    size_t chunkStart = 0;
+    uint64_t hash = 0;
+    
+    for (size_t i = 0; i < content.length(); ++i) {
+        hash = (hash << 1) + GEAR_TABLE[static_cast<unsigned char>(content[i])];
+        
+        if (content[i] != '\n') {
+            continue;
+        }
+        
+        size_t chunkSize = i + 1 - chunkStart;
+        bool isBoundary = (hash >> (64 - BOUNDARY_BITS)) == 0;
+        
+        if ((chunkSize >= MIN_CHUNK_SIZE && isBoundary) || chunkSize >= MAX_CHUNK_SIZE) {
+            result.push_back(content.substr(chunkStart, chunkSize));
+            chunkStart = i + 1;
+        }
+    }
+    
+    if (chunkStart < content.length()) {
+        result.push_back(content.substr(chunkStart));
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Parses the lines of a chunk into columns.
+ * 
+ * Lines that cannot be parsed are skipped, as with readShoppingListFromFile.
+ * 
+ * @param content The lines.
+ * @param names The dictionary to intern the item names in.
+ * @return The columns.
+ */
+ItemColumns parseChunkColumns(const std::string_view &content, NameInterner &names) {
+    ItemColumns columns;
+    std::string_view remaining = content;
+    
+    while (!remaining.empty()) {
+        size_t lineEnd = remaining.find('\n');
+        std::string line = std::string(remaining.substr(0, lineEnd));
+        
+        remaining = lineEnd == std::string_view::npos ? std::string_view() : remaining.substr(lineEnd + 1);
+        
+        if (line.empty() || startsWith(line, "//")) {
+            continue;
+        }
+        
+        try {
+            ShoppingListItem shoppingListItem = parseShoppingListItemStr(line);
+            
+            columns.nameIds.push_back(names.intern(shoppingListItem.name));
+            columns.priceCentsPerUnit.push_back(shoppingListItem.priceCentsPerUnit);
+            columns.counts.push_back(shoppingListItem.count);
+            columns.countTypes.push_back(shoppingListItem.countType);
+            columns.perUnitCounts.push_back(shoppingListItem.perUnitCount);
+            columns.perUnitCountTypes.push_back(shoppingListItem.perUnitCountType);
+        } catch (std::runtime_error& e) {
+            // Ignore errors and continue to the next line.
+        }
+    }
+    
+    return columns;
+}
+
+/**
+ * @brief Builds an item from a row of columns.
+ * 
+ * @param columns The columns.
+ * @param row The index of the row.
+ * @param name The name of the item.
+ * @return The item.
+ */
+ShoppingListItem getColumnsItem(const ItemColumns &columns, size_t row, const std::string &name) {
+    return ShoppingListItem {
+        .name = name,
+        .priceCentsPerUnit = columns.priceCentsPerUnit[row],
+        .count = columns.counts[row],
+        .countType = columns.countTypes[row],
+        .perUnitCount = columns.perUnitCounts[row],
+        .perUnitCountType = columns.perUnitCountTypes[row],
+    };
+}
+
+/**
+ * @brief Computes the statistics for a chunk's items.
+ * 
+ * @param columns The items.
+ * @return The statistics. The bounds are 0 if there are no items.
+ */
+ZoneMap computeZoneMap(const ItemColumns &columns) {
+    ZoneMap zoneMap = ZoneMap {
+        .rowCount = static_cast<uint32_t>(columns.nameIds.size()),
+        .minTotalPriceCents = 0,
+        .maxTotalPriceCents = 0,
+        .minUnitPrice = 0,
+        .maxUnitPrice = 0,
+        .perUnitCountTypeMask = 0,
+    };
+    std::string noName = "";
+    
+    for (size_t row = 0; row < columns.nameIds.size(); ++row) {
+        ShoppingListItem shoppingListItem = getColumnsItem(columns, row, noName);
+        int64_t totalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
+        double unitPrice = getShoppingListItemUnitPrice(shoppingListItem, Unit::Pound);
+        
+        if (row == 0) {
+            zoneMap.minTotalPriceCents = totalPriceCents;
+            zoneMap.maxTotalPriceCents = totalPriceCents;
+            zoneMap.minUnitPrice = unitPrice;
+            zoneMap.maxUnitPrice = unitPrice;
+        } else {
+            zoneMap.minTotalPriceCents = std::min(zoneMap.minTotalPriceCents, totalPriceCents);
+            zoneMap.maxTotalPriceCents = std::max(zoneMap.maxTotalPriceCents, totalPriceCents);
+            zoneMap.minUnitPrice = std::min(zoneMap.minUnitPrice, unitPrice);
+            zoneMap.maxUnitPrice = std::max(zoneMap.maxUnitPrice, unitPrice);
+        }
+        
+        zoneMap.perUnitCountTypeMask |= getCountTypeBit(shoppingListItem.perUnitCountType);
+    }
+    
+    return zoneMap;
+}
+
+/**
+ * @brief Checks whether any item in a chunk may match a filter, using only its statistics.
+ * 
+ * @param zoneMap The statistics for the chunk.
+ * @param filter The filter.
+ * @return False if no item in the chunk can match.
+ */
+bool mayMatchZoneMap(const ZoneMap &zoneMap, const ItemFilter &filter) {
+    if (zoneMap.rowCount == 0) {
+        return false;
+    }
+    
+    if (filter.perUnitCountTypeMask != 0 && (zoneMap.perUnitCountTypeMask & filter.perUnitCountTypeMask) == 0) {
+        return false;
+    }
+    
+    if (filter.minTotalPriceCents.has_value() && zoneMap.maxTotalPriceCents < *filter.minTotalPriceCents) {
+        return false;
+    }
+    
+    if (filter.maxTotalPriceCents.has_value() && zoneMap.minTotalPriceCents > *filter.maxTotalPriceCents) {
+        return false;
+    }
+    
+    if (filter.minUnitPrice.has_value() && zoneMap.maxUnitPrice < *filter.minUnitPrice) {
+        return false;
+    }
+    
+    if (filter.maxUnitPrice.has_value() && zoneMap.minUnitPrice > *filter.maxUnitPrice) {
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Encodes columns as the bytes stored in an archive.
+ * 
+ * @param columns The columns.
+ * @return The bytes of each column in turn.
+ */
+std::string encodeItemColumns(const ItemColumns &columns) {
+    std::string out;
+    
+    appendColumn(out, columns.nameIds);
+    appendColumn(out, columns.priceCentsPerUnit);
+    appendColumn(out, columns.counts);
+    appendColumn(out, columns.countTypes);
+    appendColumn(out, columns.perUnitCounts);
+    appendColumn(out, columns.perUnitCountTypes);
+    
+    return out;
+}
+
+/**
+ * @brief Decodes the columns of a chunk.
+ * 
+ * The bounds of the name ids are checked here rather than when the archive is read, since chunks
+ * are only decoded when a lookup reads them.
+ * 
+ * @param in The bytes of the columns.
+ * @param rowCount The number of rows.
+ * @param nameCount The number of names in the archive.
+ * @return The columns.
+ */
+ItemColumns decodeItemColumns(std::string_view in, size_t rowCount, size_t nameCount) {
+    ItemColumns columns;
+    
+    columns.nameIds = readColumn<uint32_t>(in, rowCount);
+    columns.priceCentsPerUnit = readColumn<int64_t>(in, rowCount);
+    columns.counts = readColumn<double>(in, rowCount);
+    columns.countTypes = readColumn<CountType>(in, rowCount);
+    columns.perUnitCounts = readColumn<int64_t>(in, rowCount);
+    columns.perUnitCountTypes = readColumn<CountType>(in, rowCount);
+    
+    for (uint32_t nameId : columns.nameIds) {
+        if (nameId >= nameCount) {
+            throw std::runtime_error("Invalid name id in list archive");
+        }
+    }
+    
+    return columns;
+}
+
+/**
+ * @brief Gets the number of bytes the columns of a number of rows take in an archive.
+ * 
+ * @param rowCount The number of rows.
+ * @return The number of bytes.
+ */
+size_t getEncodedColumnsLength(size_t rowCount) {
+    return rowCount * (sizeof(uint32_t) + sizeof(int64_t) + sizeof(double) + sizeof(CountType) + sizeof(int64_t) + sizeof(CountType));
+}
+
+/**
+ * @brief Decodes the items of a stored chunk.
+ * 
+ * @param chunk The chunk.
+ * @return The columns.
+ */
+ItemColumns ListArchive::decodeChunkColumns(const ArchiveChunk &chunk) const {
+    return decodeItemColumns(chunk.encodedColumns, chunk.zoneMap.rowCount, names.size());
+}
+
+/**
+ * @brief Finds a chunk with the same content, or stores and parses it if there is none.
+ * 
+ * @param content The content of the chunk.
+ * @param isNovel Set to whether the chunk was new.
+ * @return The id of the chunk.
+ */
+uint32_t ListArchive::storeChunk(const std::string_view &content, bool &isNovel) {
+    uint64_t hash = hashString(content);
+    uint64_t key = hash;
+    
+    // Probe past other content with a colliding hash.
+    for (auto it = chunkIds.find(key); it != chunkIds.end(); it = chunkIds.find(++key)) {
+        if (chunks[it->second].content == content) {
+            isNovel = false;
+            
+            return it->second;
+        }
+    }
+    
+    uint32_t id = static_cast<uint32_t>(chunks.size());
+    
+    ItemColumns columns = parseChunkColumns(content, names);
+    
+    chunks.push_back(ArchiveChunk {
+        .hash = hash,
+        .content = std::string(content),
+        .encodedColumns = encodeItemColumns(columns),
+        .zoneMap = computeZoneMap(columns),
+    });
+    chunkIds.emplace(key, id);
+    isNovel = true;
+    
+    return id;
+}
+
+/**
+ * @brief Adds a list to the archive. Only chunks that are not already stored are parsed.
+ * 
+ * Replaces any list with the same name.
+ * 
+ * @param name The name of the list.
+ * @param content The content of the list.
+ * @return The number of chunks and how many of them were new.
+ */
+ArchiveAddResult ListArchive::addList(const std::string &name, const std::string_view &content) {
+    ArchiveList list = ArchiveList {
+        .name = name,
+        .chunkIds = {},
+    };
+    ArchiveAddResult result = ArchiveAddResult {
+        .chunkCount = 0,
+        .novelChunkCount = 0,
+        .novelByteCount = 0,
+    };
+    
+    for (const std::string_view &chunk : splitContentDefinedChunks(content)) {
+        bool isNovel = false;
+        
+        list.chunkIds.push_back(storeChunk(chunk, isNovel));
+        result.chunkCount++;
+        
+        if (isNovel) {
+            result.novelChunkCount++;
+            result.novelByteCount += chunk.length();
+        }
+    }
+    
+    for (ArchiveList &existing : lists) {
+        if (existing.name == name) {
+            existing = std::move(list);
+            
+            return result;
+        }
+    }
+    
+    lists.push_back(std::move(list));
+    
+    return result;
+}
+
+/**
+ * @brief Adds a list to the archive by reading it from a file. The list is named by its path.
+ * 
+ * @param filePath The path to the shopping list file.
+ * @return The number of chunks and how many of them were new.
+ */
+ArchiveAddResult ListArchive::addFile(const std::string &filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file.");
+    }
+    
+    std::stringstream contents;
+    
+    contents << file.rdbuf();
+    
+    return addList(filePath, contents.str());
+}
+
+/**
+ * @brief Gets a list by name.
+ * 
+ * @param name The name of the list.
+ * @return The list.
+ */
+const ArchiveList &ListArchive::getList(const std::string &name) const {
+    for (const ArchiveList &list : lists) {
+        if (list.name == name) {
+            return list;
+        }
+    }
+    
+    throw std::runtime_error("No list named \"" + name + "\" in the archive");
+}
+
+/**
+ * @brief Gets the items of a list from the parsed chunks, without parsing anything.
+ * 
+ * @param name The name of the list.
+ * @return The items in the order they appear in the list.
+ */
+std::vector<ShoppingListItem> ListArchive::getListItems(const std::string &name) const {
+    std::vector<ShoppingListItem> shoppingListItems;
+    
+    for (uint32_t chunkId : getList(name).chunkIds) {
+        ItemColumns columns = decodeChunkColumns(chunks[chunkId]);
+        
+        for (size_t i = 0; i < columns.nameIds.size(); ++i) {
+            shoppingListItems.push_back(getColumnsItem(columns, i, names.getName(columns.nameIds[i])));
+        }
+    }
+    
+    return shoppingListItems;
+}
+
+/**
+ * @brief Gets the items of a list that match a filter.
+ * 
+ * Chunks whose statistics rule out the filter are skipped without decoding their items, and only
+ * matching items are built.
+ * 
+ * @param name The name of the list.
+ * @param filter The filter.
+ * @return The matching items and the number of chunks that were decoded.
+ */
+ArchiveLookup ListArchive::findListItems(const std::string &name, const ItemFilter &filter) const {
+    const ArchiveList &list = getList(name);
+    ArchiveLookup lookup = ArchiveLookup {
+        .items = {},
+        .scannedChunkCount = 0,
+        .chunkCount = list.chunkIds.size(),
+    };
+    std::string noName = "";
+    
+    for (uint32_t chunkId : list.chunkIds) {
+        const ArchiveChunk &chunk = chunks[chunkId];
+        
+        if (!mayMatchZoneMap(chunk.zoneMap, filter)) {
+            continue;
+        }
+        
+        lookup.scannedChunkCount++;
+        
+        ItemColumns columns = decodeChunkColumns(chunk);
+        
+        for (size_t i = 0; i < columns.nameIds.size(); ++i) {
+            ShoppingListItem shoppingListItem = getColumnsItem(columns, i, noName);
+            
+            if (matchesItemFilter(shoppingListItem, filter)) {
+                shoppingListItem.name = names.getName(columns.nameIds[i]);
+                lookup.items.push_back(std::move(shoppingListItem));
+            }
+        }
+    }
+    
+    return lookup;
+}
+
+/**
+ * @brief Rebuilds the content of a list from its chunks.
+ * 
+ * @param name The name of the list.
+ * @return The content, identical to what was added.
+ */
+std::string ListArchive::getListContent(const std::string &name) const {
+    std::string content;
+    
+    for (uint32_t chunkId : getList(name).chunkIds) {
+        content += chunks[chunkId].content;
+    }
+    
+    return content;
+}
+
+/**
+ * @brief Gets the number of lists in the archive.
+ * 
+ * @return The number of lists.
+ */
+size_t ListArchive::getListCount() const {
+    return lists.size();
+}
+
+/**
+ * @brief Gets the number of unique chunks in the archive.
+ * 
+ * @return The number of chunks.
+ */
+size_t ListArchive::getChunkCount() const {
+    return chunks.size();
+}
+
+/**
+ * @brief Gets the number of content bytes stored, counting each unique chunk once.
+ * 
+ * @return The number of bytes.
+ */
+size_t ListArchive::getStoredByteCount() const {
+    size_t byteCount = 0;
+    
+    for (const ArchiveChunk &chunk : chunks) {
+        byteCount += chunk.content.length();
+    }
+    
+    return byteCount;
+}
+
+/**
+ * @brief Serializes the archive to a binary buffer.
+ * 
+ * @return The buffer.
+ */
+std::string ListArchive::serialize() const {
+    std::string out;
+    
+    appendBinary(out, LIST_ARCHIVE_MAGIC);
+    appendBinary(out, static_cast<uint32_t>(names.size()));
+    
+    for (uint32_t id = 0; id < names.size(); ++id) {
+        const std::string &name = names.getName(id);
+        
+        appendBinary(out, static_cast<uint32_t>(name.length()));
+        out.append(name);
+    }
+    
+    appendBinary(out, static_cast<uint32_t>(chunks.size()));
+    
+    for (const ArchiveChunk &chunk : chunks) {
+        appendBinary(out, chunk.hash);
+        appendBinary(out, static_cast<uint32_t>(chunk.content.length()));
+        out.append(chunk.content);
+        appendBinary(out, chunk.zoneMap.rowCount);
+        out.append(chunk.encodedColumns);
+        appendBinary(out, chunk.zoneMap.rowCount);
+        appendBinary(out, chunk.zoneMap.minTotalPriceCents);
+        appendBinary(out, chunk.zoneMap.maxTotalPriceCents);
+        appendBinary(out, chunk.zoneMap.minUnitPrice);
+        appendBinary(out, chunk.zoneMap.maxUnitPrice);
+        appendBinary(out, chunk.zoneMap.perUnitCountTypeMask);
+    }
+    
+    appendBinary(out, static_cast<uint32_t>(lists.size()));
+    
+    for (const ArchiveList &list : lists) {
+        appendBinary(out, static_cast<uint32_t>(list.name.length()));
+        out.append(list.name);
+        appendBinary(out, static_cast<uint32_t>(list.chunkIds.size()));
+        appendColumn(out, list.chunkIds);
+    }
+    
+    return out;
+}
+
+/**
+ * @brief Reads an archive from a binary buffer.
+ * 
+ * The columns of each chunk are kept as bytes and only decoded when a lookup reads the chunk.
+ * 
+ * @param in The buffer.
+ * @return The archive.
+ */
+ListArchive ListArchive::deserialize(std::string_view in) {
+    uint32_t magic = readBinary<uint32_t>(in);
+    
+    if (magic != LIST_ARCHIVE_MAGIC && magic != LIST_ARCHIVE_V1_MAGIC) {
+        throw std::runtime_error("Not a list archive buffer");
+    }
+    
+    ListArchive archive;
+    uint32_t nameCount = readBinary<uint32_t>(in);
+    
+    for (uint32_t i = 0; i < nameCount; ++i) {
+        uint32_t nameLength = readBinary<uint32_t>(in);
+        
+        archive.names.intern(readBinaryBytes(in, nameLength));
+    }
+    
+    uint32_t chunkCount = readBinary<uint32_t>(in);
+    
+    for (uint32_t id = 0; id < chunkCount; ++id) {
+        ArchiveChunk chunk;
+        
+        chunk.hash = readBinary<uint64_t>(in);
+        chunk.content = std::string(readBinaryBytes(in, readBinary<uint32_t>(in)));
+        
+        uint32_t rowCount = readBinary<uint32_t>(in);
+        
+        chunk.encodedColumns = std::string(readBinaryBytes(in, getEncodedColumnsLength(rowCount)));
+        
+        if (magic == LIST_ARCHIVE_V1_MAGIC) {
+            // Older archives have no statistics, so they are computed from the items.
+            chunk.zoneMap = computeZoneMap(decodeItemColumns(chunk.encodedColumns, rowCount, nameCount));
+        } else {
+            chunk.zoneMap.rowCount = readBinary<uint32_t>(in);
+            chunk.zoneMap.minTotalPriceCents = readBinary<int64_t>(in);
+            chunk.zoneMap.maxTotalPriceCents = readBinary<int64_t>(in);
+            chunk.zoneMap.minUnitPrice = readBinary<double>(in);
+            chunk.zoneMap.maxUnitPrice = readBinary<double>(in);
+            chunk.zoneMap.perUnitCountTypeMask = readBinary<uint8_t>(in);
+            
+            if (chunk.zoneMap.rowCount != rowCount) {
+                throw std::runtime_error("Invalid row count in list archive");
+            }
+        }
+        
+        uint64_t key = chunk.hash;
+        
+        while (archive.chunkIds.count(key) > 0) {
+            key++;
+        }
+        
+        archive.chunkIds.emplace(key, id);
+        archive.chunks.push_back(std::move(chunk));
+    }
+    
+    uint32_t listCount = readBinary<uint32_t>(in);
+    
+    for (uint32_t i = 0; i < listCount; ++i) {
+        ArchiveList list;
+        
+        list.name = std::string(readBinaryBytes(in, readBinary<uint32_t>(in)));
+        list.chunkIds = readColumn<uint32_t>(in, readBinary<uint32_t>(in));
+        
+        for (uint32_t chunkId : list.chunkIds) {
+            if (chunkId >= chunkCount) {
+                throw std::runtime_error("Invalid chunk id in list archive");
+            }
+        }
+        
+        archive.lists.push_back(std::move(list));
+    }
+    
+    return archive;
+}
+
+/**
+ * @brief Reads an archive from a file.
+ * 
+ * @param filePath The path to the archive file.
+ * @return The archive, or an empty archive if the file does not exist.
+ */
+ListArchive readListArchive(const std::string &filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    
+    if (!file.is_open()) {
+        return ListArchive();
+    }
+    
+    std::stringstream contents;
+    
+    contents << file.rdbuf();
+    
+    return ListArchive::deserialize(contents.str());
+}
+
+/**
+ * @brief Writes an archive to a file, replacing it.
+ * 
+ * The archive is written to a temporary file that is renamed over the old one, so a failed write
+ * leaves the old archive in place.
+ * 
+ * @param filePath The path to the archive file.
+ * @param archive The archive.
+ */
+void writeListArchive(const std::string &filePath, const ListArchive &archive) {
+    replaceFile(filePath, archive.serialize());
+}
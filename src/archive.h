@@ -0,0 +1,134 @@
+/**
+ * @file archive.h
+ * @author Julia
+ * @brief Declares an archive of shopping lists that stores repeated content once.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "unit.h"
+#include "interner.h"
+#include "shopping_list.h"
+#include "item_filter.h"
+
+/// The parsed items of a chunk, stored by column.
+struct ItemColumns {
+    /// The name ids of the items.
+    std::vector<uint32_t> nameIds;
+    /// The prices of the items in cents, per unit.
+    std::vector<int64_t> priceCentsPerUnit;
+    /// The counts of the items.
+    std::vector<double> counts;
+    /// The types of count for the items.
+    std::vector<CountType> countTypes;
+    /// The counts of the per units.
+    std::vector<int64_t> perUnitCounts;
+    /// The types of count for the prices per unit.
+    std::vector<CountType> perUnitCountTypes;
+};
+
+/// Statistics for the items in a chunk, used to skip chunks that cannot match a filter.
+struct ZoneMap {
+    /// The number of items.
+    uint32_t rowCount;
+    /// The lowest total price in cents.
+    int64_t minTotalPriceCents;
+    /// The highest total price in cents.
+    int64_t maxTotalPriceCents;
+    /// The lowest unit price in cents per pound, or per item for counted items.
+    double minUnitPrice;
+    /// The highest unit price in cents per pound, or per item for counted items.
+    double maxUnitPrice;
+    /// Bit n is set if an item is priced by the CountType with value n.
+    uint8_t perUnitCountTypeMask;
+};
+
+/// A unique run of lines stored in the archive.
+struct ArchiveChunk {
+    /// The hash of the content.
+    uint64_t hash;
+    /// The lines, including their line breaks.
+    std::string content;
+    /// The items parsed from the lines, as the column bytes written to the archive. Only decoded
+    /// when a lookup reads the chunk.
+    std::string encodedColumns;
+    /// The statistics for the items. The row count is the number of rows in the columns.
+    ZoneMap zoneMap;
+};
+
+/// A shopping list stored in the archive as a sequence of chunks.
+struct ArchiveList {
+    /// The name of the list.
+    std::string name;
+    /// The ids of the chunks that make up the list, in order.
+    std::vector<uint32_t> chunkIds;
+};
+
+/// The outcome of adding a list to the archive.
+struct ArchiveAddResult {
+    /// The number of chunks in the list.
+    size_t chunkCount;
+    /// The number of chunks that were not already stored and had to be parsed.
+    size_t novelChunkCount;
+    /// The number of bytes in the novel chunks.
+    size_t novelByteCount;
+};
+
+/// The items found by a filtered lookup.
+struct ArchiveLookup {
+    /// The matching items in the order they appear in the list.
+    std::vector<ShoppingListItem> items;
+    /// The number of chunks whose items were decoded. The others were skipped by their zone maps.
+    size_t scannedChunkCount;
+    /// The number of chunks in the list.
+    size_t chunkCount;
+};
+
+/// Stores shopping lists split at content-defined line boundaries, keeping each unique chunk once.
+class ListArchive {
+public:
+    ArchiveAddResult addList(const std::string &name, const std::string_view &content);
+    ArchiveAddResult addFile(const std::string &filePath);
+    std::vector<ShoppingListItem> getListItems(const std::string &name) const;
+    ArchiveLookup findListItems(const std::string &name, const ItemFilter &filter) const;
+    std::string getListContent(const std::string &name) const;
+    size_t getListCount() const;
+    size_t getChunkCount() const;
+    size_t getStoredByteCount() const;
+    std::string serialize() const;
+    static ListArchive deserialize(std::string_view in);
+
+private:
+    uint32_t storeChunk(const std::string_view &content, bool &isNovel);
+    const ArchiveList &getList(const std::string &name) const;
+    ItemColumns decodeChunkColumns(const ArchiveChunk &chunk) const;
+    
+    /// The item names used by the chunks.
+    NameInterner names;
+    /// The unique chunks by id.
+    std::vector<ArchiveChunk> chunks;
+    /// Maps content hashes to chunk ids.
+    std::unordered_map<uint64_t, uint32_t> chunkIds;
+    /// The lists in the order they were added.
+    std::vector<ArchiveList> lists;
+};
+
+ItemColumns parseChunkColumns(const std::string_view &content, NameInterner &names);
+ShoppingListItem getColumnsItem(const ItemColumns &columns, size_t row, const std::string &name);
+bool mayMatchZoneMap(const ZoneMap &zoneMap, const ItemFilter &filter);
+std::vector<std::string_view> splitContentDefinedChunks(const std::string_view &content);
+ListArchive readListArchive(const std::string &filePath);
+void writeListArchive(const std::string &filePath, const ListArchive &archive);
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * @file batch.cpp
+ * @author Julia
+ * @brief Implements functions for processing many shopping list files at once.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "unit.h"
+#include "utils.h"
+#include "section.h"
+#include "display.h"
+#include "batch.h"
+
+/**
+ * @brief Prints every file followed by the section subtotals across all files.
+ * 
+ * @param filePaths The paths to the shopping list files.
+ * @param options The print options for each file.
+ * @return The total price of all files in cents.
+ */
+int64_t runBatch(const std::vector<std::string> &filePaths, const PrintOptions &options) {
+    SectionTotals sectionTotals;
+    int64_t totalPriceCents = 0;
+    
+    for (const std::string &filePath : filePaths) {
+        std::cout << "== " << filePath << " ==" << std::endl;
+        
+        try {
+            int64_t fileTotalPriceCents = printShoppingListFile(filePath, options, sectionTotals);
+            
+            std::cout << "\nTotal: $" << centsToDollars(fileTotalPriceCents) << "\n" << std::endl;
+            totalPriceCents += fileTotalPriceCents;
+        } catch (std::runtime_error& e) {
+            std::cerr << "Failed to read file \"" << filePath << "\": " << e.what() << "; skipping" << std::endl;
+        }
+    }
+    
+    std::cout << "== All files ==" << std::endl;
+    
+    // Without sections every item is in the unnamed section, so only the total is printed.
+    if (options.useSections) {
+        for (const SectionTotal &sectionTotal : sectionTotals.getTotals()) {
+            std::string name = sectionTotal.name.empty() ? "(No section)" : sectionTotal.name;
+            
+            std::cout << name << ": $" << centsToDollars(sectionTotal.totalPriceCents);
+            std::cout << " (" << sectionTotal.itemCount << " items)" << std::endl;
+        }
+    }
+    
+    std::cout << "\nTotal: $" << centsToDollars(totalPriceCents) << std::endl;
+    
+    return totalPriceCents;
+}
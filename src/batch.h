@@ -0,0 +1,24 @@
+/**
+ * @file batch.h
+ * @author Julia
+ * @brief Declares functions for processing many shopping list files at once.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "unit.h"
+#include "section.h"
+#include "display.h"
+
+int64_t runBatch(const std::vector<std::string> &filePaths, const PrintOptions &options);
+
+#endif
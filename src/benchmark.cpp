@@ -0,0 +1,311 @@
+/**
+ * @file benchmark.cpp
+ * @author Julia
+ * @brief Microbenchmarks for the parser and its helpers.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "utils.h"
+#include "buffered_writer.h"
+#include "catalog.h"
+#include "benchmark.h"
+
+/**
+ * @brief The byte-by-byte trimFromFront that the SIMD version replaced, kept for comparison.
+ * 
+ * @param sView The string to trim.
+ * @return True if the string was trimmed, false otherwise.
+ */
+bool legacyTrimFromFront(std::string_view &sView) {
+    size_t start = 0;
+    
+    while (start < sView.length() && std::isspace(sView[start])) {
+        start++;
+    }
+    
+    sView = std::string_view(sView.data() + start, sView.length() - start);
+    
+    return start > 0;
+}
+
+/**
+ * @brief The byte-by-byte trimFromBack that the SIMD version replaced, kept for comparison.
+ * 
+ * @param sView The string to trim.
+ * @return True if the string was trimmed, false otherwise.
+ */
+bool legacyTrimFromBack(std::string_view &sView) {
+    if (sView.empty()) {
+        return false;
+    }
+    
+    size_t end = sView.length() - 1;
+    size_t originalEnd = end;
+    
+    while (end > 0 && std::isspace(sView[end])) {
+        end--;
+    }
+    
+    sView = std::string_view(sView.data(), sView.length() - (originalEnd - end));
+    
+    return originalEnd != end;
+}
+
+/**
+ * @brief The byte-by-byte digit scan that the parser used before, kept for comparison.
+ * 
+ * @param sView The string to scan.
+ * @return The number of trailing digits.
+ */
+size_t legacyCountTrailingDigits(const std::string_view &sView) {
+    size_t count = 0;
+    
+    for (size_t i = sView.length() - 1; i < sView.length(); --i) {
+        if (!std::isdigit(sView[i])) {
+            break;
+        }
+        
+        count++;
+    }
+    
+    return count;
+}
+
+/**
+ * @brief Times a function over a set of inputs.
+ * 
+ * @param name The name to print.
+ * @param inputs The inputs.
+ * @param fn The function to time. Returns a value so the work is not optimized away.
+ */
+void timeStringFunction(const std::string &name, const std::vector<std::string> &inputs, const std::function<size_t(std::string_view)> &fn) {
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+    
+    /// Number of passes over the inputs.
+    size_t iterCount = 200000;
+    size_t checksum = 0;
+    
+    // Warm up the CPU before running the benchmark.
+    for (size_t i = 0; i < iterCount / 10; ++i) {
+        checksum += fn(inputs[i % inputs.size()]);
+    }
+    
+    auto t1 = high_resolution_clock::now();
+    
+    for (size_t i = 0; i < iterCount; ++i) {
+        checksum += fn(inputs[i % inputs.size()]);
+    }
+    
+    auto t2 = high_resolution_clock::now();
+    /// The duration in nanoseconds.
+    duration<double, std::nano> ns_double = t2 - t1;
+    
+    std::cout << std::left << std::setw(32) << name;
+    std::cout << std::fixed << std::setprecision(2) << ns_double.count() / iterCount << "ns";
+    std::cout << " (checksum " << checksum << ")" << std::endl;
+}
+
+/**
+ * @brief Compares the string helpers against the byte-by-byte versions they replaced.
+ */
+void runStringUtilsBenchmark() {
+    std::vector<std::string> inputs = {
+        "2 lb. Chicken Breasts, $4.99 / lb.",
+        "   10 Sweet Corn, 5 / $2.00   ",
+        std::string(40, ' ') + "Corn Chex, $2.79" + std::string(40, ' '),
+        "Paper Towels, $12345678901234567890",
+    };
+    
+    timeStringFunction("legacy trimFromFront", inputs, [](std::string_view sView) {
+        legacyTrimFromFront(sView);
+        return sView.length();
+    });
+    timeStringFunction("trimFromFront", inputs, [](std::string_view sView) {
+        trimFromFront(sView);
+        return sView.length();
+    });
+    timeStringFunction("legacy trimFromBack", inputs, [](std::string_view sView) {
+        legacyTrimFromBack(sView);
+        return sView.length();
+    });
+    timeStringFunction("trimFromBack", inputs, [](std::string_view sView) {
+        trimFromBack(sView);
+        return sView.length();
+    });
+    timeStringFunction("legacy trailing digits", inputs, [](std::string_view sView) {
+        return legacyCountTrailingDigits(sView);
+    });
+    timeStringFunction("countTrailingDigits", inputs, [](std::string_view sView) {
+        return countTrailingDigits(sView);
+    });
+    timeStringFunction("findLastOfSet", inputs, [](std::string_view sView) {
+        return findLastOfSet(sView, "$/");
+    });
+}
+
+/**
+ * @brief Times running the program once on a file, many times over.
+ * 
+ * @param programPath The path to the program.
+ * @param args The arguments to run the program with.
+ * @param runCount The number of runs.
+ * @return The mean wall time of a run in microseconds.
+ */
+double timeProgramRuns(const char *programPath, const std::vector<std::string> &args, size_t runCount) {
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+    
+    std::vector<char *> argv;
+    
+    argv.push_back(const_cast<char *>(programPath));
+    
+    for (const std::string &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    
+    argv.push_back(nullptr);
+    
+    // Discard the output so only the program is timed.
+    posix_spawn_file_actions_t fileActions;
+    
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_addopen(&fileActions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&fileActions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    
+    auto t1 = high_resolution_clock::now();
+    
+    for (size_t i = 0; i < runCount; ++i) {
+        pid_t pid;
+        int status;
+        
+        if (posix_spawn(&pid, programPath, &fileActions, nullptr, argv.data(), environ) != 0) {
+            posix_spawn_file_actions_destroy(&fileActions);
+            throw std::runtime_error("Failed to run the program.");
+        }
+        
+        waitpid(pid, &status, 0);
+    }
+    
+    auto t2 = high_resolution_clock::now();
+    /// The duration in microseconds.
+    duration<double, std::micro> us_double = t2 - t1;
+    
+    posix_spawn_file_actions_destroy(&fileActions);
+    
+    return us_double.count() / runCount;
+}
+
+/**
+ * @brief Compares the startup cost of the default program and the lean program on a 10-line list.
+ * 
+ * @param programPath The path to this program, e.g. argv[0].
+ * @param leanProgramPath The path to the lean program, e.g. "bin/main-lean".
+ */
+void runStartupBenchmark(const char *programPath, const char *leanProgramPath) {
+    /// Number of runs of each path.
+    size_t runCount = 200;
+    std::string filePath = "/tmp/shopping-list-startup-benchmark.txt";
+    std::string list = "";
+    
+    for (size_t i = 0; i < 10; ++i) {
+        list += std::to_string(i + 1) + " lb. Chicken Breasts, $4.99 / lb.\n";
+    }
+    
+    int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create the benchmark list.");
+    }
+    
+    writeAll(fd, list);
+    ::close(fd);
+    
+    // Run each once first so the program is in the page cache.
+    timeProgramRuns(programPath, {filePath}, 1);
+    timeProgramRuns(leanProgramPath, {filePath}, 1);
+    
+    double defaultUs = timeProgramRuns(programPath, {filePath}, runCount);
+    double leanUs = timeProgramRuns(leanProgramPath, {filePath}, runCount);
+    
+    std::cout << std::left << std::setw(32) << "default program";
+    std::cout << std::fixed << std::setprecision(2) << defaultUs << "us" << std::endl;
+    std::cout << std::left << std::setw(32) << "lean program";
+    std::cout << std::fixed << std::setprecision(2) << leanUs << "us" << std::endl;
+    
+    ::unlink(filePath.c_str());
+}
+
+/**
+ * @brief Times catalog lookups of misspelled names in a catalog whose names share their words.
+ * 
+ * Real catalogs reuse a small vocabulary, such as brands, descriptions and sizes, so many names
+ * share most of their trigrams. That is the worst case for the trigram index.
+ */
+void runCatalogBenchmark() {
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+    
+    std::vector<std::string> brands = {"Kroger", "Great Value", "Kirkland", "Store Brand", "Simple Truth", "Market Pantry", "Good & Gather", "Trader Joe's", "365", "Signature Select"};
+    std::vector<std::string> descriptions = {"Organic", "Whole", "Low Fat", "Fat Free", "Unsweetened", "Original", "Family Size", "Lightly Salted", "Extra Large", "Reduced Sodium"};
+    std::vector<std::string> products = {"Milk", "Eggs", "Butter", "Yogurt", "Cheddar Cheese", "Bread", "Orange Juice", "Peanut Butter", "Chicken Breasts", "Ground Beef", "Rice", "Pasta", "Tomato Sauce", "Black Beans", "Corn Chex", "Apples", "Bananas", "Carrots", "Spinach", "Coffee"};
+    std::vector<std::string> sizes = {"8 oz", "12 oz", "16 oz", "32 oz", "1 gal", "2 lb", "5 lb", "6 ct", "12 ct", "18 ct"};
+    FuzzyCatalog catalog;
+    std::vector<std::string> lookups;
+    
+    for (const std::string &brand : brands) {
+        for (const std::string &description : descriptions) {
+            for (const std::string &product : products) {
+                for (const std::string &size : sizes) {
+                    std::string name = brand + " " + description + " " + product + " " + size;
+                    
+                    catalog.add(name);
+                    
+                    // Misspell every 97th name by swapping two of its letters.
+                    if (catalog.size() % 97 == 0) {
+                        size_t i = name.length() / 2;
+                        
+                        std::swap(name[i], name[i + 1]);
+                        lookups.push_back(name);
+                    }
+                }
+            }
+        }
+    }
+    
+    // Short names are looked up too, since their distance allows the weakest filter.
+    for (const std::string &product : products) {
+        lookups.push_back(product.substr(1));
+    }
+    
+    size_t matchCount = 0;
+    auto t1 = high_resolution_clock::now();
+    
+    for (const std::string &lookup : lookups) {
+        matchCount += catalog.findBestMatch(lookup).has_value() ? 1 : 0;
+    }
+    
+    auto t2 = high_resolution_clock::now();
+    /// The duration in microseconds.
+    duration<double, std::micro> us_double = t2 - t1;
+    
+    std::cout << "findBestMatch: " << std::fixed << std::setprecision(2) << us_double.count() / lookups.size() << "us per lookup, ";
+    std::cout << matchCount << " of " << lookups.size() << " matched in " << catalog.size() << " names" << std::endl;
+}
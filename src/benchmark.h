@@ -0,0 +1,19 @@
+/**
+ * @file benchmark.h
+ * @author Julia
+ * @brief Declares microbenchmarks for the parser and its helpers.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+#pragma once
+
+void runStringUtilsBenchmark();
+void runStartupBenchmark(const char *programPath, const char *leanProgramPath);
+void runCatalogBenchmark();
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file binary_io.h
+ * @author Julia
+ * @brief Helpers for writing and reading fixed-size values in binary buffers.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Appends the bytes of a value to a buffer.
+ * 
+ * @tparam T A trivially copyable type.
+ * @param out The buffer.
+ * @param value The value.
+ */
+template<typename T>
+inline void appendBinary(std::string &out, const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Value must be trivially copyable");
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * @brief Reads a value from the front of a buffer.
+ * 
+ * Advances the string view to exclude the value.
+ * 
+ * @tparam T A trivially copyable type.
+ * @param in The buffer.
+ * @return The value.
+ */
+template<typename T>
+inline T readBinary(std::string_view &in) {
+    static_assert(std::is_trivially_copyable<T>::value, "Value must be trivially copyable");
+    
+    if (in.length() < sizeof(T)) {
+        throw std::runtime_error("Unexpected end of binary data");
+    }
+    
+    T value;
+    
+    std::memcpy(&value, in.data(), sizeof(T));
+    in = std::string_view(in.data() + sizeof(T), in.length() - sizeof(T));
+    
+    return value;
+}
+
+/**
+ * @brief Reads a number of bytes from the front of a buffer.
+ * 
+ * Advances the string view to exclude the bytes.
+ * 
+ * @param in The buffer.
+ * @param length The number of bytes.
+ * @return A view of the bytes.
+ */
+inline std::string_view readBinaryBytes(std::string_view &in, size_t length) {
+    if (in.length() < length) {
+        throw std::runtime_error("Unexpected end of binary data");
+    }
+    
+    std::string_view bytes = std::string_view(in.data(), length);
+    
+    in = std::string_view(in.data() + length, in.length() - length);
+    
+    return bytes;
+}
+
+/**
+ * @brief Appends a column to a binary buffer.
+ * 
+ * @tparam T A trivially copyable type.
+ * @param out The buffer.
+ * @param column The column.
+ */
+template<typename T>
+inline void appendColumn(std::string &out, const std::vector<T> &column) {
+    out.append(reinterpret_cast<const char *>(column.data()), column.size() * sizeof(T));
+}
+
+/**
+ * @brief Reads a column from a binary buffer.
+ * 
+ * Advances the string view to exclude the column.
+ * 
+ * @tparam T A trivially copyable type.
+ * @param in The buffer.
+ * @param rowCount The number of values in the column.
+ * @return The column.
+ */
+template<typename T>
+inline std::vector<T> readColumn(std::string_view &in, size_t rowCount) {
+    std::string_view bytes = readBinaryBytes(in, rowCount * sizeof(T));
+    std::vector<T> column = std::vector<T>(rowCount);
+    
+    std::memcpy(column.data(), bytes.data(), bytes.length());
+    
+    return column;
+}
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file bloom_filter.cpp
+ * @author Julia
+ * @brief Implements a compact Bloom filter over string hashes.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "binary_io.h"
+#include "bloom_filter.h"
+
+/**
+ * @brief Creates a Bloom filter sized for a number of keys.
+ * 
+ * @param expectedCount The number of keys expected to be inserted.
+ * @param bitsPerKey The number of bits to use per key. 10 bits gives roughly a 1% false positive
+ * rate.
+ */
+BloomFilter::BloomFilter(size_t expectedCount, size_t bitsPerKey) {
+    // Always keep at least one word so an empty filter is still valid.
+    size_t wordCount = std::max<size_t>(1, (expectedCount * bitsPerKey + 63) / 64);
+    
+    words = std::vector<uint64_t>(wordCount, 0);
+    bitCount = wordCount * 64;
+    // The optimal number of probes is bitsPerKey * ln(2).
+    probeCount = static_cast<uint32_t>(std::clamp<size_t>((bitsPerKey * 69) / 100, 1, 16));
+}
+
+/**
+ * @brief Inserts a hash into the filter.
+ * 
+ * @param hash The hash of the key.
+ */
+void BloomFilter::insert(uint64_t hash) {
+    // Double hashing: derive all probes from the two halves of the hash.
+    uint64_t h1 = hash & 0xffffffff;
+    uint64_t h2 = (hash >> 32) | 1;
+    
+    for (uint32_t i = 0; i < probeCount; ++i) {
+        size_t bit = (h1 + i * h2) % bitCount;
+        
+        words[bit / 64] |= (1ULL << (bit % 64));
+    }
+}
+
+/**
+ * @brief Checks if a hash may have been inserted into the filter.
+ * 
+ * @param hash The hash of the key.
+ * @return False if the key was definitely never inserted, true otherwise.
+ */
+bool BloomFilter::mayContain(uint64_t hash) const {
+    uint64_t h1 = hash & 0xffffffff;
+    uint64_t h2 = (hash >> 32) | 1;
+    
+    for (uint32_t i = 0; i < probeCount; ++i) {
+        size_t bit = (h1 + i * h2) % bitCount;
+        
+        if ((words[bit / 64] & (1ULL << (bit % 64))) == 0) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Gets the number of bits in the filter.
+ * 
+ * @return The number of bits.
+ */
+size_t BloomFilter::getBitCount() const {
+    return bitCount;
+}
+
+/**
+ * @brief Appends the filter to a binary buffer.
+ * 
+ * @param out The buffer.
+ */
+void BloomFilter::serialize(std::string &out) const {
+    appendBinary(out, probeCount);
+    appendBinary(out, static_cast<uint32_t>(words.size()));
+    appendColumn(out, words);
+}
+
+/**
+ * @brief Reads a filter from a binary buffer.
+ * 
+ * Advances the string view to exclude the filter.
+ * 
+ * @param in The buffer.
+ * @return The filter.
+ */
+BloomFilter BloomFilter::deserialize(std::string_view &in) {
+    BloomFilter filter = BloomFilter(0);
+    
+    filter.probeCount = readBinary<uint32_t>(in);
+    filter.words = readColumn<uint64_t>(in, readBinary<uint32_t>(in));
+    filter.bitCount = filter.words.size() * 64;
+    
+    if (filter.words.empty() || filter.probeCount == 0 || filter.probeCount > 16) {
+        throw std::runtime_error("Invalid Bloom filter");
+    }
+    
+    return filter;
+}
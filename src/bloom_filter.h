@@ -0,0 +1,40 @@
+/**
+ * @file bloom_filter.h
+ * @author Julia
+ * @brief Declares a compact Bloom filter over string hashes.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// A Bloom filter over 64-bit hashes.
+class BloomFilter {
+public:
+    BloomFilter(size_t expectedCount, size_t bitsPerKey = 10);
+    
+    void insert(uint64_t hash);
+    bool mayContain(uint64_t hash) const;
+    size_t getBitCount() const;
+    void serialize(std::string &out) const;
+    static BloomFilter deserialize(std::string_view &in);
+
+private:
+    /// The bits of the filter.
+    std::vector<uint64_t> words;
+    /// The number of bits in the filter.
+    size_t bitCount;
+    /// The number of probes per key.
+    uint32_t probeCount;
+};
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @file buffered_writer.cpp
+ * @author Julia
+ * @brief Implements a writer that batches output into large writes to a file descriptor.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "buffered_writer.h"
+
+/**
+ * @brief Writes all of a string to a file descriptor, retrying short writes.
+ * 
+ * @param fd The file descriptor.
+ * @param s The string to write.
+ */
+void writeAll(int fd, const std::string_view &s) {
+    const char *data = s.data();
+    size_t remaining = s.length();
+    
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            
+            throw std::runtime_error("Failed to write output.");
+        }
+        
+        data += written;
+        remaining -= written;
+    }
+}
+
+/**
+ * @brief Writes all of a string to a file descriptor at an offset, retrying short writes.
+ * 
+ * Does not move the file position, so several threads can write to different regions at once.
+ * 
+ * @param fd The file descriptor.
+ * @param s The string to write.
+ * @param offset The offset in the file to write at.
+ */
+void pwriteAll(int fd, const std::string_view &s, uint64_t offset) {
+    const char *data = s.data();
+    size_t remaining = s.length();
+    
+    while (remaining > 0) {
+        ssize_t written = ::pwrite(fd, data, remaining, static_cast<off_t>(offset));
+        
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            
+            throw std::runtime_error("Failed to write output.");
+        }
+        
+        data += written;
+        remaining -= written;
+        offset += written;
+    }
+}
+
+/**
+ * @brief Replaces the contents of a file without readers ever seeing a partial file.
+ * 
+ * The contents are written to a uniquely named temporary file next to it, synced to disk and
+ * renamed over the file, so concurrent writers and crashes leave either the old or the new file.
+ * 
+ * @param filePath The path to the file.
+ * @param contents The new contents.
+ */
+void replaceFile(const std::string &filePath, const std::string_view &contents) {
+    std::string tempFilePath = filePath + ".XXXXXX";
+    int fd = ::mkstemp(tempFilePath.data());
+    
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create \"" + tempFilePath + "\"");
+    }
+    
+    try {
+        // mkstemp only lets the owner read the file.
+        if (::fchmod(fd, 0644) != 0) {
+            throw std::runtime_error("Failed to set permissions of \"" + tempFilePath + "\"");
+        }
+        
+        writeAll(fd, contents);
+        
+        if (::fsync(fd) != 0) {
+            throw std::runtime_error("Failed to sync \"" + tempFilePath + "\"");
+        }
+    } catch (std::runtime_error& e) {
+        ::close(fd);
+        std::remove(tempFilePath.c_str());
+        throw;
+    }
+    
+    ::close(fd);
+    
+    if (std::rename(tempFilePath.c_str(), filePath.c_str()) != 0) {
+        std::remove(tempFilePath.c_str());
+        throw std::runtime_error("Failed to replace \"" + filePath + "\"");
+    }
+}
+
+/**
+ * @brief Creates a writer.
+ * 
+ * @param fd The file descriptor to write to. It is not closed by the writer.
+ * @param capacity The number of bytes to buffer before writing.
+ */
+BufferedWriter::BufferedWriter(int fd, size_t capacity) : capacity(capacity) {
+    sink = [fd](const std::string_view &s) {
+        writeAll(fd, s);
+    };
+    buffer.reserve(capacity);
+}
+
+/**
+ * @brief Creates a writer that passes its output to a function.
+ * 
+ * @param sink Receives each batch of output.
+ * @param capacity The number of bytes to buffer before passing them on.
+ */
+BufferedWriter::BufferedWriter(std::function<void(const std::string_view &)> sink, size_t capacity) :
+    sink(std::move(sink)),
+    capacity(capacity) {
+    buffer.reserve(capacity);
+}
+
+/**
+ * @brief Flushes any pending output.
+ */
+BufferedWriter::~BufferedWriter() {
+    try {
+        flush();
+    } catch (std::runtime_error& e) {
+        // Destructors must not throw. Call flush explicitly to handle errors.
+    }
+}
+
+/**
+ * @brief Appends a string to the output.
+ * 
+ * @param s The string.
+ */
+void BufferedWriter::append(const std::string_view &s) {
+    buffer.append(s.data(), s.length());
+    flushIfFull();
+}
+
+/**
+ * @brief Gets the pending output so rows can be rendered into it directly.
+ * 
+ * Call flushIfFull after appending to it.
+ * 
+ * @return The buffer.
+ */
+std::string &BufferedWriter::getBuffer() {
+    return buffer;
+}
+
+/**
+ * @brief Writes the pending output if it has reached the capacity.
+ */
+void BufferedWriter::flushIfFull() {
+    if (buffer.length() >= capacity) {
+        flush();
+    }
+}
+
+/**
+ * @brief Writes the pending output.
+ */
+void BufferedWriter::flush() {
+    if (buffer.empty()) {
+        return;
+    }
+    
+    sink(buffer);
+    buffer.clear();
+}
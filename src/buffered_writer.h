@@ -0,0 +1,47 @@
+/**
+ * @file buffered_writer.h
+ * @author Julia
+ * @brief Declares a writer that batches output into large writes to a file descriptor.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/// Batches output into large writes to a file descriptor or another sink.
+class BufferedWriter {
+public:
+    BufferedWriter(int fd, size_t capacity = 1 << 16);
+    BufferedWriter(std::function<void(const std::string_view &)> sink, size_t capacity = 1 << 16);
+    BufferedWriter(const BufferedWriter &other) = delete;
+    BufferedWriter &operator=(const BufferedWriter &other) = delete;
+    ~BufferedWriter();
+    
+    void append(const std::string_view &s);
+    std::string &getBuffer();
+    void flushIfFull();
+    void flush();
+
+private:
+    /// Receives each batch of output, e.g. by writing it to a file descriptor.
+    std::function<void(const std::string_view &)> sink;
+    /// The number of bytes to buffer before writing.
+    size_t capacity;
+    /// The pending output.
+    std::string buffer;
+};
+
+void writeAll(int fd, const std::string_view &s);
+void pwriteAll(int fd, const std::string_view &s, uint64_t offset);
+void replaceFile(const std::string &filePath, const std::string_view &contents);
+
+#endif
@@ -0,0 +1,462 @@
+/**
+ * @file cache_snapshot.cpp
+ * @author Julia
+ * @brief Implements a memory-mapped snapshot of the parse cache and name dictionary.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * The file is a header followed by tables that refer to each other by byte offsets from the start
+ * of the file, so it can be mapped at any address and used in place:
+ * 
+ *   header | name table | name hash slots | entry hash slots | string bytes
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "utils.h"
+#include "interner.h"
+#include "binary_io.h"
+#include "parse_cache.h"
+#include "shopping_list.h"
+#include "buffered_writer.h"
+#include "cache_snapshot.h"
+
+/// Identifies snapshot files.
+uint32_t const SNAPSHOT_MAGIC = 0x31435350; // "PSC1"
+/// The version of the snapshot layout.
+uint32_t const SNAPSHOT_VERSION = 1;
+
+/// The header at the start of a snapshot file.
+struct SnapshotHeader {
+    /// Identifies the file as a snapshot.
+    uint32_t magic;
+    /// The version of the layout.
+    uint32_t version;
+    /// The number of names.
+    uint32_t nameCount;
+    /// The number of slots in the name hash table. Always a power of two.
+    uint32_t nameSlotCount;
+    /// The number of parsed lines.
+    uint32_t entryCount;
+    /// The number of slots in the entry hash table. Always a power of two.
+    uint32_t entrySlotCount;
+    /// The offset of the name table.
+    uint64_t nameTableOffset;
+    /// The offset of the name hash table.
+    uint64_t nameSlotsOffset;
+    /// The offset of the entry hash table.
+    uint64_t entrySlotsOffset;
+    /// The length of the file, to detect truncation.
+    uint64_t fileLength;
+};
+
+/// A name in the name table.
+struct SnapshotName {
+    /// The offset of the name bytes.
+    uint64_t offset;
+    /// The length of the name.
+    uint32_t length;
+    /// Padding.
+    uint32_t reserved;
+};
+
+/// A parsed line in the entry hash table.
+struct SnapshotEntry {
+    /// The hash of the line.
+    uint64_t lineHash;
+    /// The offset of the line bytes.
+    uint64_t lineOffset;
+    /// The length of the line.
+    uint32_t lineLength;
+    /// The id of the item name.
+    uint32_t nameId;
+    /// The price of the item in cents, per unit.
+    int64_t priceCentsPerUnit;
+    /// The count of the item.
+    double count;
+    /// The count of the per unit.
+    int64_t perUnitCount;
+    /// The type of count for the item.
+    uint8_t countType;
+    /// The type of count for the price per unit.
+    uint8_t perUnitCountType;
+    /// Whether the slot holds an entry.
+    uint8_t isOccupied;
+    /// Padding.
+    uint8_t reserved[5];
+};
+
+/**
+ * @brief Gets the number of hash slots for a number of keys, keeping the load under one half.
+ * 
+ * @param count The number of keys.
+ * @return A power of two.
+ */
+uint32_t getSlotCount(size_t count) {
+    uint32_t slotCount = 1;
+    
+    while (slotCount < count * 2) {
+        slotCount *= 2;
+    }
+    
+    return slotCount;
+}
+
+/**
+ * @brief Pads a buffer with zeros to a multiple of 8 bytes.
+ * 
+ * @param out The buffer.
+ */
+void padToAlignment(std::string &out) {
+    out.append((8 - out.length() % 8) % 8, '\0');
+}
+
+/**
+ * @brief Writes a snapshot of a parse cache and name dictionary.
+ * 
+ * Entries from a snapshot attached to the cache are carried over. The file is replaced with
+ * replaceFile, so a running process never sees a partial snapshot and a crash leaves either the
+ * old or the new one.
+ * Call this at shutdown and periodically while running.
+ * 
+ * @param filePath The path to the snapshot file.
+ * @param parseCache The parse cache.
+ * @param names The name dictionary.
+ */
+void writeCacheSnapshot(const std::string &filePath, const ParseCache &parseCache, const NameInterner &names) {
+    // Gather the lines from the cache and any snapshot it was started from.
+    std::vector<std::pair<std::string_view, const ShoppingListItem *>> lines;
+    std::vector<std::pair<std::string, ShoppingListItem>> snapshotLines;
+    NameInterner allNames = names;
+    
+    for (const auto &[line, shoppingListItem] : parseCache.getEntries()) {
+        lines.emplace_back(line, &shoppingListItem);
+    }
+    
+    if (parseCache.getSnapshot()) {
+        parseCache.getSnapshot()->forEachEntry([&](std::string_view line, const ShoppingListItem &shoppingListItem) {
+            if (parseCache.getEntries().count(std::string(line)) == 0) {
+                snapshotLines.emplace_back(std::string(line), shoppingListItem);
+            }
+        });
+    }
+    
+    for (const auto &[line, shoppingListItem] : snapshotLines) {
+        lines.emplace_back(line, &shoppingListItem);
+    }
+    
+    for (const auto &[line, shoppingListItem] : lines) {
+        allNames.intern(shoppingListItem->name);
+    }
+    
+    SnapshotHeader header = SnapshotHeader {};
+    
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.nameCount = static_cast<uint32_t>(allNames.size());
+    header.nameSlotCount = getSlotCount(allNames.size());
+    header.entryCount = static_cast<uint32_t>(lines.size());
+    header.entrySlotCount = getSlotCount(lines.size());
+    header.nameTableOffset = sizeof(SnapshotHeader);
+    header.nameSlotsOffset = header.nameTableOffset + header.nameCount * sizeof(SnapshotName);
+    header.entrySlotsOffset = header.nameSlotsOffset + header.nameSlotCount * sizeof(uint32_t);
+    header.entrySlotsOffset += (8 - header.entrySlotsOffset % 8) % 8;
+    
+    uint64_t stringsOffset = header.entrySlotsOffset + header.entrySlotCount * sizeof(SnapshotEntry);
+    std::string strings;
+    std::vector<SnapshotName> nameTable = std::vector<SnapshotName>(header.nameCount);
+    std::vector<uint32_t> nameSlots = std::vector<uint32_t>(header.nameSlotCount, 0);
+    std::vector<SnapshotEntry> entrySlots = std::vector<SnapshotEntry>(header.entrySlotCount, SnapshotEntry {});
+    
+    for (uint32_t id = 0; id < header.nameCount; ++id) {
+        const std::string &name = allNames.getName(id);
+        
+        nameTable[id] = SnapshotName {
+            .offset = stringsOffset + strings.length(),
+            .length = static_cast<uint32_t>(name.length()),
+            .reserved = 0,
+        };
+        strings += name;
+        
+        // Linear probing.
+        uint32_t slot = hashString(name) & (header.nameSlotCount - 1);
+        
+        while (nameSlots[slot] != 0) {
+            slot = (slot + 1) & (header.nameSlotCount - 1);
+        }
+        
+        nameSlots[slot] = id + 1;
+    }
+    
+    for (const auto &[line, shoppingListItem] : lines) {
+        uint64_t lineHash = hashString(line);
+        uint32_t slot = lineHash & (header.entrySlotCount - 1);
+        
+        while (entrySlots[slot].isOccupied) {
+            slot = (slot + 1) & (header.entrySlotCount - 1);
+        }
+        
+        SnapshotEntry &entry = entrySlots[slot];
+        
+        entry.lineHash = lineHash;
+        entry.lineOffset = stringsOffset + strings.length();
+        entry.lineLength = static_cast<uint32_t>(line.length());
+        entry.nameId = *allNames.find(shoppingListItem->name);
+        entry.priceCentsPerUnit = shoppingListItem->priceCentsPerUnit;
+        entry.count = shoppingListItem->count;
+        entry.perUnitCount = shoppingListItem->perUnitCount;
+        entry.countType = static_cast<uint8_t>(shoppingListItem->countType);
+        entry.perUnitCountType = static_cast<uint8_t>(shoppingListItem->perUnitCountType);
+        entry.isOccupied = 1;
+        strings.append(line.data(), line.length());
+    }
+    
+    header.fileLength = stringsOffset + strings.length();
+    
+    std::string out;
+    
+    out.reserve(header.fileLength);
+    appendBinary(out, header);
+    out.append(reinterpret_cast<const char *>(nameTable.data()), nameTable.size() * sizeof(SnapshotName));
+    out.append(reinterpret_cast<const char *>(nameSlots.data()), nameSlots.size() * sizeof(uint32_t));
+    padToAlignment(out);
+    out.append(reinterpret_cast<const char *>(entrySlots.data()), entrySlots.size() * sizeof(SnapshotEntry));
+    out += strings;
+    
+    replaceFile(filePath, out);
+}
+
+/**
+ * @brief Maps a snapshot file.
+ * 
+ * Only the header, table bounds and load of the hash tables are checked; pages are loaded lazily
+ * as lookups touch them.
+ * 
+ * @param filePath The path to the snapshot file.
+ * @return The snapshot.
+ */
+std::shared_ptr<const CacheSnapshot> CacheSnapshot::open(const std::string &filePath) {
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open snapshot file.");
+    }
+    
+    struct stat fileStat;
+    
+    if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Invalid snapshot file.");
+    }
+    
+    size_t length = fileStat.st_size;
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    
+    // The mapping stays valid after the file is closed.
+    ::close(fd);
+    
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map snapshot file.");
+    }
+    
+    // Owned by the snapshot from here on so the mapping is released on errors.
+    std::shared_ptr<const CacheSnapshot> snapshot(new CacheSnapshot(static_cast<const char *>(mapping), length));
+    const SnapshotHeader &header = *snapshot->header;
+    
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION) {
+        throw std::runtime_error("Invalid snapshot file.");
+    }
+    
+    uint64_t entrySlotsEnd = header.entrySlotsOffset + static_cast<uint64_t>(header.entrySlotCount) * sizeof(SnapshotEntry);
+    
+    if (
+        header.fileLength != length ||
+        (header.nameSlotCount & (header.nameSlotCount - 1)) != 0 ||
+        (header.entrySlotCount & (header.entrySlotCount - 1)) != 0 ||
+        // Every table has an empty slot to end probes, as written by getSlotCount.
+        static_cast<uint64_t>(header.nameCount) * 2 > header.nameSlotCount ||
+        static_cast<uint64_t>(header.entryCount) * 2 > header.entrySlotCount ||
+        header.nameTableOffset < sizeof(SnapshotHeader) ||
+        header.nameTableOffset + static_cast<uint64_t>(header.nameCount) * sizeof(SnapshotName) > header.nameSlotsOffset ||
+        header.nameSlotsOffset + static_cast<uint64_t>(header.nameSlotCount) * sizeof(uint32_t) > header.entrySlotsOffset ||
+        header.entrySlotsOffset % 8 != 0 ||
+        entrySlotsEnd > length
+    ) {
+        throw std::runtime_error("Invalid snapshot file.");
+    }
+    
+    return snapshot;
+}
+
+/**
+ * @brief Creates a snapshot over a mapped file.
+ * 
+ * @param data The mapped file.
+ * @param length The length of the mapped file.
+ */
+CacheSnapshot::CacheSnapshot(const char *data, size_t length) :
+    data(data),
+    length(length),
+    header(reinterpret_cast<const SnapshotHeader *>(data)),
+    names(reinterpret_cast<const SnapshotName *>(data + header->nameTableOffset)),
+    nameSlots(reinterpret_cast<const uint32_t *>(data + header->nameSlotsOffset)),
+    entrySlots(reinterpret_cast<const SnapshotEntry *>(data + header->entrySlotsOffset)) {}
+
+/**
+ * @brief Unmaps the file.
+ */
+CacheSnapshot::~CacheSnapshot() {
+    munmap(const_cast<char *>(data), length);
+}
+
+/**
+ * @brief Converts an entry to a shopping list item.
+ * 
+ * @param entry The entry.
+ * @return The shopping list item.
+ */
+ShoppingListItem CacheSnapshot::toShoppingListItem(const SnapshotEntry &entry) const {
+    return ShoppingListItem {
+        .name = std::string(getName(entry.nameId)),
+        .priceCentsPerUnit = entry.priceCentsPerUnit,
+        .count = entry.count,
+        .countType = static_cast<CountType>(entry.countType),
+        .perUnitCount = entry.perUnitCount,
+        .perUnitCountType = static_cast<CountType>(entry.perUnitCountType),
+    };
+}
+
+/**
+ * @brief Finds the parsed item for a line.
+ * 
+ * Probes stop after every slot has been visited, so a damaged file with no empty slot cannot
+ * loop forever.
+ * 
+ * @param line The shopping list line.
+ * @return An optional containing the item if the line is in the snapshot.
+ */
+std::optional<ShoppingListItem> CacheSnapshot::findParsedLine(const std::string_view &line) const {
+    if (header->entrySlotCount == 0) {
+        return std::nullopt;
+    }
+    
+    uint64_t lineHash = hashString(line);
+    uint32_t mask = header->entrySlotCount - 1;
+    
+    uint32_t slot = lineHash & mask;
+    
+    for (uint32_t probeCount = 0; probeCount < header->entrySlotCount && entrySlots[slot].isOccupied; ++probeCount) {
+        const SnapshotEntry &entry = entrySlots[slot];
+        
+        if (
+            entry.lineHash == lineHash &&
+            entry.lineLength == line.length() &&
+            entry.lineOffset + entry.lineLength <= length &&
+            std::memcmp(data + entry.lineOffset, line.data(), line.length()) == 0
+        ) {
+            return toShoppingListItem(entry);
+        }
+        
+        slot = (slot + 1) & mask;
+    }
+    
+    return std::nullopt;
+}
+
+/**
+ * @brief Finds the id of a name.
+ * 
+ * Probes stop after every slot has been visited.
+ * 
+ * @param name The name.
+ * @return An optional containing the id if the name is in the snapshot.
+ */
+std::optional<uint32_t> CacheSnapshot::findNameId(const std::string_view &name) const {
+    if (header->nameSlotCount == 0) {
+        return std::nullopt;
+    }
+    
+    uint32_t mask = header->nameSlotCount - 1;
+    
+    uint32_t slot = hashString(name) & mask;
+    
+    for (uint32_t probeCount = 0; probeCount < header->nameSlotCount && nameSlots[slot] != 0; ++probeCount) {
+        uint32_t id = nameSlots[slot] - 1;
+        
+        if (getName(id) == name) {
+            return id;
+        }
+        
+        slot = (slot + 1) & mask;
+    }
+    
+    return std::nullopt;
+}
+
+/**
+ * @brief Gets a name by id.
+ * 
+ * @param id The id.
+ * @return A view of the name in the mapping.
+ */
+std::string_view CacheSnapshot::getName(uint32_t id) const {
+    if (id >= header->nameCount) {
+        throw std::runtime_error("Invalid name id");
+    }
+    
+    const SnapshotName &name = names[id];
+    
+    if (name.offset + name.length > length) {
+        throw std::runtime_error("Invalid snapshot file.");
+    }
+    
+    return std::string_view(data + name.offset, name.length);
+}
+
+/**
+ * @brief Gets the number of names.
+ * 
+ * @return The number of names.
+ */
+size_t CacheSnapshot::getNameCount() const {
+    return header->nameCount;
+}
+
+/**
+ * @brief Gets the number of parsed lines.
+ * 
+ * @return The number of lines.
+ */
+size_t CacheSnapshot::getEntryCount() const {
+    return header->entryCount;
+}
+
+/**
+ * @brief Calls a function for every parsed line.
+ * 
+ * @param callback Called with the line and its item.
+ */
+void CacheSnapshot::forEachEntry(const std::function<void(std::string_view, const ShoppingListItem &)> &callback) const {
+    for (uint32_t slot = 0; slot < header->entrySlotCount; ++slot) {
+        const SnapshotEntry &entry = entrySlots[slot];
+        
+        if (!entry.isOccupied || entry.lineOffset + entry.lineLength > length) {
+            continue;
+        }
+        
+        callback(std::string_view(data + entry.lineOffset, entry.lineLength), toShoppingListItem(entry));
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * @file cache_snapshot.h
+ * @author Julia
+ * @brief Declares a memory-mapped snapshot of the parse cache and name dictionary.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef CACHE_SNAPSHOT_H
+#define CACHE_SNAPSHOT_H
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "interner.h"
+#include "parse_cache.h"
+#include "shopping_list.h"
+
+struct SnapshotHeader;
+struct SnapshotName;
+struct SnapshotEntry;
+
+/// A read-only snapshot mapped from a file. Lookups read the mapping directly without rebuilding
+/// any in-memory structures.
+class CacheSnapshot {
+public:
+    static std::shared_ptr<const CacheSnapshot> open(const std::string &filePath);
+    CacheSnapshot(const CacheSnapshot &other) = delete;
+    CacheSnapshot &operator=(const CacheSnapshot &other) = delete;
+    ~CacheSnapshot();
+    
+    std::optional<ShoppingListItem> findParsedLine(const std::string_view &line) const;
+    std::optional<uint32_t> findNameId(const std::string_view &name) const;
+    std::string_view getName(uint32_t id) const;
+    size_t getNameCount() const;
+    size_t getEntryCount() const;
+    void forEachEntry(const std::function<void(std::string_view, const ShoppingListItem &)> &callback) const;
+
+private:
+    CacheSnapshot(const char *data, size_t length);
+    
+    ShoppingListItem toShoppingListItem(const SnapshotEntry &entry) const;
+    
+    /// The mapped file.
+    const char *data;
+    /// The length of the mapped file.
+    size_t length;
+    /// The header at the start of the file.
+    const SnapshotHeader *header;
+    /// The names by id.
+    const SnapshotName *names;
+    /// The hash table of name ids. Each slot holds id + 1, or 0 if empty.
+    const uint32_t *nameSlots;
+    /// The hash table of parsed lines.
+    const SnapshotEntry *entrySlots;
+};
+
+void writeCacheSnapshot(const std::string &filePath, const ParseCache &parseCache, const NameInterner &names);
+
+#endif
@@ -0,0 +1,306 @@
+/**
+ * @file catalog.cpp
+ * @author Julia
+ * @brief Implements a catalog of item names with typo-tolerant lookups.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "interner.h"
+#include "shopping_list.h"
+#include "catalog.h"
+
+/// The largest edit distance a lookup accepts by default. Longer names share more of their
+/// trigrams with other names, so a distance that grows with the length would make every name that
+/// shares a few words with the lookup a candidate.
+int const MAX_DEFAULT_DISTANCE = 3;
+
+/**
+ * @brief Gets the distinct trigrams of a name, padded with a space at each end.
+ * 
+ * The padding gives the first and last characters their own trigrams, so typos at the ends of a
+ * name are caught.
+ * 
+ * @param name The normalized name.
+ * @return The trigrams, each packed into the low 24 bits of an integer.
+ */
+std::vector<uint32_t> getTrigrams(const std::string_view &name) {
+    std::string padded = " " + std::string(name) + " ";
+    std::vector<uint32_t> trigrams;
+    
+    for (size_t i = 0; i + 3 <= padded.length(); ++i) {
+        trigrams.push_back(
+            static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16 |
+            static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+            static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2]))
+        );
+    }
+    
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    
+    return trigrams;
+}
+
+/**
+ * @brief Gets the key of the posting list for a trigram in names of a length.
+ * 
+ * Splitting the lists by length means a lookup only reads names whose length is within the edit
+ * distance of its own.
+ * 
+ * @param trigram The trigram.
+ * @param length The length of the name. Lengths from 255 up share a list.
+ * @return The key.
+ */
+uint32_t getPostingKey(uint32_t trigram, size_t length) {
+    return trigram << 8 | static_cast<uint32_t>(std::min<size_t>(length, 255));
+}
+
+/**
+ * @brief Computes the edit distance between a pattern of up to 64 bytes and a text.
+ * 
+ * Uses Myers' bit-parallel algorithm, which keeps a column of the edit distance table as bit
+ * vectors of the differences between neighbouring cells and advances it a whole column per byte.
+ * 
+ * @param pattern The pattern. At most 64 bytes.
+ * @param text The text.
+ * @return The number of single byte insertions, deletions and substitutions.
+ */
+uint32_t computeMyersDistance(const std::string_view &pattern, const std::string_view &text) {
+    uint64_t peq[256] = {};
+    
+    for (size_t i = 0; i < pattern.length(); ++i) {
+        peq[static_cast<unsigned char>(pattern[i])] |= 1ULL << i;
+    }
+    
+    uint64_t lastBit = 1ULL << (pattern.length() - 1);
+    // The vertical differences are all +1 in the first column.
+    uint64_t pv = ~0ULL;
+    uint64_t mv = 0;
+    uint32_t score = static_cast<uint32_t>(pattern.length());
+    
+    for (char c : text) {
+        uint64_t eq = peq[static_cast<unsigned char>(c)];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        
+        if (ph & lastBit) {
+            score++;
+        } else if (mh & lastBit) {
+            score--;
+        }
+        
+        // The first row grows by 1 per column, since the whole prefix of the text must be matched.
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    
+    return score;
+}
+
+/**
+ * @brief Computes the edit distance between two strings.
+ * 
+ * @param a The first string.
+ * @param b The second string.
+ * @return The number of single byte insertions, deletions and substitutions.
+ */
+uint32_t computeEditDistance(const std::string_view &a, const std::string_view &b) {
+    const std::string_view &shorter = a.length() <= b.length() ? a : b;
+    const std::string_view &longer = a.length() <= b.length() ? b : a;
+    
+    if (shorter.empty()) {
+        return static_cast<uint32_t>(longer.length());
+    }
+    
+    if (shorter.length() <= 64) {
+        return computeMyersDistance(shorter, longer);
+    }
+    
+    // Names this long are rare, so they use the table one row at a time.
+    std::vector<uint32_t> row = std::vector<uint32_t>(shorter.length() + 1);
+    
+    for (size_t i = 0; i <= shorter.length(); ++i) {
+        row[i] = static_cast<uint32_t>(i);
+    }
+    
+    for (size_t j = 1; j <= longer.length(); ++j) {
+        uint32_t diagonal = row[0];
+        
+        row[0] = static_cast<uint32_t>(j);
+        
+        for (size_t i = 1; i <= shorter.length(); ++i) {
+            uint32_t above = row[i];
+            uint32_t substitution = diagonal + (shorter[i - 1] == longer[j - 1] ? 0 : 1);
+            
+            row[i] = std::min({row[i - 1] + 1, above + 1, substitution});
+            diagonal = above;
+        }
+    }
+    
+    return row[shorter.length()];
+}
+
+/**
+ * @brief Adds a name to the catalog.
+ * 
+ * @param name The name.
+ * @return The id of the name. Names that normalize to the same name share an id.
+ */
+uint32_t FuzzyCatalog::add(const std::string_view &name) {
+    std::string normalizedName = normalizeItemName(name);
+    uint32_t id = normalizedNames.intern(normalizedName);
+    
+    if (id < names.size()) {
+        return id;
+    }
+    
+    names.emplace_back(name);
+    
+    for (uint32_t trigram : getTrigrams(normalizedName)) {
+        postings[getPostingKey(trigram, normalizedName.length())].push_back(id);
+    }
+    
+    return id;
+}
+
+/**
+ * @brief Finds the catalog name closest to a name.
+ * 
+ * Candidates come from the trigram index, for names whose length is within the distance. An edit
+ * changes at most 3 trigrams, so a name within the distance shares a minimum number of trigrams
+ * with the lookup. By the pigeonhole principle, such a name appears in at least one of the
+ * shortest posting lists, so only those are scanned and the longer lists are binary searched for
+ * each candidate, stopping as soon as it cannot reach the minimum. The candidates that pass are
+ * checked with the bit-parallel edit distance.
+ * 
+ * @param name The name to look up.
+ * @param maxDistance The largest edit distance to accept, or -1 for a quarter of the length, from 1
+ * up to MAX_DEFAULT_DISTANCE.
+ * @return An optional containing the closest match, or nothing if no name is close enough.
+ */
+std::optional<CatalogMatch> FuzzyCatalog::findBestMatch(const std::string_view &name, int maxDistance) const {
+    std::string normalizedName = normalizeItemName(name);
+    std::optional<uint32_t> exactIdOpt = normalizedNames.find(normalizedName);
+    
+    if (exactIdOpt.has_value()) {
+        return CatalogMatch {
+            .id = *exactIdOpt,
+            .name = names[*exactIdOpt],
+            .distance = 0,
+            .score = 1,
+        };
+    }
+    
+    if (maxDistance < 0) {
+        maxDistance = std::clamp<int>(static_cast<int>(normalizedName.length() / 4), 1, MAX_DEFAULT_DISTANCE);
+    }
+    
+    std::vector<uint32_t> trigrams = getTrigrams(normalizedName);
+    int minSharedCount = std::max<int>(1, static_cast<int>(trigrams.size()) - 3 * maxDistance);
+    size_t minLength = normalizedName.length() > static_cast<size_t>(maxDistance) ? normalizedName.length() - maxDistance : 0;
+    
+    minLength = std::min<size_t>(minLength, 255);
+    
+    size_t maxLength = std::min<size_t>(normalizedName.length() + maxDistance, 255);
+    std::optional<CatalogMatch> bestMatch;
+    
+    for (size_t length = minLength; length <= maxLength; ++length) {
+        std::vector<const std::vector<uint32_t> *> lists;
+        
+        for (uint32_t trigram : trigrams) {
+            auto it = postings.find(getPostingKey(trigram, length));
+            
+            if (it != postings.end()) {
+                lists.push_back(&it->second);
+            }
+        }
+        
+        if (static_cast<int>(lists.size()) < minSharedCount) {
+            continue;
+        }
+        
+        std::sort(lists.begin(), lists.end(), [](const std::vector<uint32_t> *a, const std::vector<uint32_t> *b) {
+            return a->size() < b->size();
+        });
+        
+        // A match misses at most lists.size() - minSharedCount lists, so it is in one of these.
+        size_t scannedListCount = lists.size() - minSharedCount + 1;
+        std::vector<uint32_t> candidates;
+        
+        for (size_t i = 0; i < scannedListCount; ++i) {
+            candidates.insert(candidates.end(), lists[i]->begin(), lists[i]->end());
+        }
+        
+        std::sort(candidates.begin(), candidates.end());
+        
+        for (size_t start = 0; start < candidates.size();) {
+            uint32_t id = candidates[start];
+            size_t end = start;
+            
+            while (end < candidates.size() && candidates[end] == id) {
+                end++;
+            }
+            
+            int sharedCount = static_cast<int>(end - start);
+            
+            start = end;
+            
+            // Stop once the name shares enough trigrams, or can no longer share enough.
+            for (size_t i = scannedListCount; i < lists.size() && sharedCount < minSharedCount && sharedCount + static_cast<int>(lists.size() - i) >= minSharedCount; ++i) {
+                if (std::binary_search(lists[i]->begin(), lists[i]->end(), id)) {
+                    sharedCount++;
+                }
+            }
+            
+            if (sharedCount < minSharedCount) {
+                continue;
+            }
+            
+            const std::string &candidate = normalizedNames.getName(id);
+            uint32_t distance = computeEditDistance(normalizedName, candidate);
+            
+            if (distance > static_cast<uint32_t>(maxDistance)) {
+                continue;
+            }
+            
+            // Prefer the closest name, then the one added first.
+            if (bestMatch.has_value() && (distance > bestMatch->distance || (distance == bestMatch->distance && id > bestMatch->id))) {
+                continue;
+            }
+            
+            double longestLength = static_cast<double>(std::max(candidate.length(), normalizedName.length()));
+            
+            bestMatch = CatalogMatch {
+                .id = id,
+                .name = names[id],
+                .distance = distance,
+                .score = 1 - distance / longestLength,
+            };
+        }
+    }
+    
+    return bestMatch;
+}
+
+/**
+ * @brief Gets the number of distinct names in the catalog.
+ * 
+ * @return The number of names.
+ */
+size_t FuzzyCatalog::size() const {
+    return names.size();
+}
@@ -0,0 +1,54 @@
+/**
+ * @file catalog.h
+ * @author Julia
+ * @brief Declares a catalog of item names with typo-tolerant lookups.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef CATALOG_H
+#define CATALOG_H
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "interner.h"
+
+/// The closest catalog name to a lookup.
+struct CatalogMatch {
+    /// The id of the catalog name.
+    uint32_t id;
+    /// The catalog name as it was added.
+    std::string name;
+    /// The number of single character edits between the normalized names.
+    uint32_t distance;
+    /// The similarity from 0 to 1, where 1 is an exact match.
+    double score;
+};
+
+/// A catalog of item names indexed by trigrams for typo-tolerant lookups.
+class FuzzyCatalog {
+public:
+    uint32_t add(const std::string_view &name);
+    std::optional<CatalogMatch> findBestMatch(const std::string_view &name, int maxDistance = -1) const;
+    size_t size() const;
+
+private:
+    /// The normalized names, which the index and distances use.
+    NameInterner normalizedNames;
+    /// The names as they were first added, by id.
+    std::vector<std::string> names;
+    /// Maps a trigram and a name length to the ids of the names of that length that contain the
+    /// trigram, in increasing order. Keys come from getPostingKey.
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+};
+
+uint32_t computeEditDistance(const std::string_view &a, const std::string_view &b);
+
+#endif
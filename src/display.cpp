@@ -9,231 +9,147 @@
  */
 
 #include <iostream>
-#include <iomanip>
 #include <optional>
-#include <cmath>
+#include <string>
+#include <fstream>
+#include <stdexcept>
 #include "unit.h"
 #include "utils.h"
 #include "shopping_list.h"
+#include "section.h"
+#include "report_template.h"
+#include "display.h"
 
 /**
- * @brief Converts a weight to a displayable weight.
+ * @brief Compiles a report template for console output.
  * 
- * @param weight The weight.
- * @param unit The unit of measurement.
- * @return The displayable weight.
- */
-double displayWeight(double weight, Unit unit) {
-    if (isWhole(weight)) {
-        // This is a whole number
-        return weight;
-    }
-    
-    switch (unit) {
-        case Unit::Ounce:
-            // Convert to 1 decimal place
-            return std::round(weight * 10.0) / 10.0;
-        case Unit::Pound:
-            // Convert to 2 decimal places
-            return std::round(weight * 100.0) / 100.0;
-        case Unit::Kilogram:    
-            // Convert to 2 decimal places
-            return std::round(weight * 100.0) / 100.0;
-        case Unit::Gram:
-            return std::round(weight);
-    }
-    // Removes compiler warning about unreachable code.
-     __builtin_unreachable();
-}
-
-/// Converted price per unit result.
-struct ConvertedPerUnit {
-    // The count of the unit.
-    double perUnitCount;
-    /// The unit for the price per unit.
-    Unit perUnitUnit;
-    /// The price of the item in cents, per unit.
-    int64_t priceCentsPerUnit;
-};
-
-/**
- * @brief Calculate the conversion for the per unit.
+ * Prices use the locale of the console and columns are measured in terminal columns, so names
+ * such as "Jalapeños" still line up.
  * 
- * @param perUnitCount The count of the unit.
- * @param unit The unit.
- * @param priceCentsPerUnit The price of the item in cents, per unit. 
- * @param preferredUnit The preferred unit.
- * @return The converted per unit. 
+ * @param templateStr The template, e.g. DEFAULT_REPORT_TEMPLATE.
+ * @param preferredUnit The preferred unit of measurement.
+ * @return The compiled template.
+ * @throws std::runtime_error If the template is invalid.
  */
-ConvertedPerUnit calculateConvertedPerUnit(int64_t perUnitCount, Unit unit, int64_t priceCentsPerUnit, Unit preferredUnit) {
-    System system = getUnitSystem(unit);
-    System preferredSystem = getUnitSystem(preferredUnit);
-    double preferredPerUnitCount = static_cast<double>(perUnitCount);
+ReportTemplate compileConsoleTemplate(const std::string_view &templateStr, Unit preferredUnit) {
+    ReportTemplate reportTemplate = compileReportTemplate(templateStr, preferredUnit, MoneyFormat::Locale);
     
-    if (system == preferredSystem) {
-        // The unit is in the same system as the preferred unit.
-        return ConvertedPerUnit {
-            .perUnitCount = preferredPerUnitCount,
-            .perUnitUnit = unit,
-            .priceCentsPerUnit = priceCentsPerUnit,
-        };
-    }
+    reportTemplate.layout = ColumnLayout::DisplayWidth;
     
-    switch (unit) {
-        case Unit::Ounce:
-        case Unit::Pound:
-            preferredUnit = Unit::Kilogram;
-            break;
-        case Unit::Kilogram:
-        case Unit::Gram:
-            preferredUnit = Unit::Pound;
-            break;
-    }
-    
-    double convertedUnitCount = convertWeight(static_cast<double>(perUnitCount), unit, preferredUnit);
-    int64_t newPriceCentsPerUnit = priceCentsPerUnit;
-    
-    if (perUnitCount > 1) {
-        // We don't adjust the price but we do adjust the unit count.
-        preferredPerUnitCount = convertedUnitCount;
-    } else {
-        // Get the ratio between the new unit count and the original unit count.
-        double perUnitCountRatio = preferredPerUnitCount / static_cast<double>(convertedUnitCount);
-        // Calculate the new price per unit.
-        newPriceCentsPerUnit = static_cast<int64_t>(priceCentsPerUnit * perUnitCountRatio);
-    }
-    
-    return ConvertedPerUnit {
-        .perUnitCount = preferredPerUnitCount,
-        .perUnitUnit = preferredUnit,
-        .priceCentsPerUnit = newPriceCentsPerUnit,
-    };
+    return reportTemplate;
 }
 
 /**
- * @brief Prints an element
+ * @brief Prints a shopping list item as a row of a report template.
  * 
- * @tparam T 
- * @param t The element to print.
- * @param width The width of the column.
- * @param separator The separator to use as spaces.
+ * @param reportTemplate The compiled template.
+ * @param shoppingListItem The shopping list item.
+ * @param runningTotalCents The running total including this item, for the running column.
  */
-template<typename T>
-void printElement(T t, const int& width, const char& separator = ' ') {
-    std::cout << std::left << std::setw(width) << std::setfill(separator) << t;
+void printReportRow(const ReportTemplate &reportTemplate, const ShoppingListItem &shoppingListItem, int64_t runningTotalCents) {
+    std::string row;
+    
+    renderReportRow(reportTemplate, shoppingListItem, row, runningTotalCents);
+    std::cout << row;
 }
 
 /**
- * @brief Converts a value to a string using a stringstream.
+ * @brief Prints a shopping list item with the default console layout.
  * 
- * @tparam T 
- * @param t The element to convert.
- * @return The formatted value.
+ * @param shoppingListItem The shopping list item.
+ * @param preferredUnit The preferred unit of measurement.
+ * @param runningTotalCents The running total to print after the row, if any.
  */
-template<typename T>
-inline static const std::string toStringStreamStr(T t) {
-    std::stringstream ss;
-    ss << t;
-    return ss.str();
+void printShoppingListItem(ShoppingListItem shoppingListItem, Unit preferredUnit, std::optional<int64_t> runningTotalCents) {
+    const char *templateStr = runningTotalCents.has_value() ? RUNNING_TOTAL_REPORT_TEMPLATE : DEFAULT_REPORT_TEMPLATE;
+    
+    printReportRow(compileConsoleTemplate(templateStr, preferredUnit), shoppingListItem, runningTotalCents.value_or(0));
 }
 
 /**
- * @brief Prints a price.
+ * @brief Prints the subtotal of a section.
  * 
- * @param priceCents The price in cents.
- * @param width The width of the column.
- * @param separator The separator to use as spaces.
+ * @param totalPriceCents The subtotal in cents.
  */
-void printPriceElement(int64_t priceCents, const int& width, const char& separator = ' ') {
-    std::stringstream ss;
-    
-    ss.imbue(std::locale("en_US.UTF-8"));
-    ss << "$" << std::put_money(priceCents);
-    printElement(ss.str(), 10, separator);
+void printSectionSubtotal(int64_t totalPriceCents) {
+    std::cout << "Subtotal: $" << centsToDollars(totalPriceCents) << std::endl;
 }
 
 /**
- * @brief Prints a shopping list item.
+ * @brief Prints a shopping list file as it is read.
  * 
- * @param shoppingListItem The shopping list item.
- * @param preferredUnit The preferred unit of measurement.
+ * When sections are used, header comments such as "// Produce" start a new section and the
+ * subtotal of each section is printed as soon as the section ends, so nothing is buffered beyond
+ * the current line. Otherwise every comment is skipped. Rows are printed with the template of the
+ * options; its running column is the total of the file up to and including each row, which is
+ * already kept as rows are printed.
+ * 
+ * @param filePath The path to the shopping list file.
+ * @param options The print options.
+ * @param sectionTotals The subtotals to add each item to.
+ * @return The total price of the items in the file in cents.
  */
-void printShoppingListItem(ShoppingListItem shoppingListItem, Unit preferredUnit) {
-    const char separator = ' ';
-    
-    std::optional<Unit> unitOpt = convertCountTypeToUnit(shoppingListItem.countType);
-    std::optional<Unit> perUnitUnitOpt = convertCountTypeToUnit(shoppingListItem.perUnitCountType);
-    
-    int64_t itemTotalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
-    int64_t priceCentsPerUnit = shoppingListItem.priceCentsPerUnit;
-    int64_t perUnitCount = shoppingListItem.perUnitCount;
-    CountType perUnitCountType = shoppingListItem.perUnitCountType;
-    
-    printElement(shoppingListItem.name, 20, separator);
-    
-    std::string countColumn = "";
+int64_t printShoppingListFile(const std::string &filePath, const PrintOptions &options, SectionTotals &sectionTotals) {
+    std::ifstream file(filePath);
     
-    if (unitOpt.has_value()) {
-        // Convert the weight to preferred unit.
-        Unit unit = std::move(*unitOpt);
-        double weight = convertWeight(shoppingListItem.count, unit, preferredUnit);
-        std::string unitStr = convertUnitToString(preferredUnit);
-        
-        // Convert to a sensible precision for display.
-        countColumn = toStringStreamStr(displayWeight(weight, preferredUnit)) + " " + unitStr + ".";
-    } else {
-        // This is a quantity
-        countColumn = toStringStreamStr(shoppingListItem.count);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file.");
     }
     
-    printElement(countColumn, 10, separator);
-    
-    std::stringstream ssPerUnitColumn;
-    
-    ssPerUnitColumn.imbue(std::locale("en_US.UTF-8"));
+    int64_t totalPriceCents = 0;
+    // Items before the first header are not in a named section.
+    std::string section = "";
+    int64_t sectionTotalPriceCents = 0;
+    bool hasOutput = false;
     
-    if (perUnitUnitOpt.has_value()) {
-        Unit perUnitUnit = std::move(*perUnitUnitOpt);
-        ConvertedPerUnit convertedPerUnit = calculateConvertedPerUnit(
-            perUnitCount,
-            perUnitUnit,
-            priceCentsPerUnit,
-            preferredUnit
-        );
-        
-        perUnitCountType = convertUnitToCountType(convertedPerUnit.perUnitUnit);
-        priceCentsPerUnit = convertedPerUnit.priceCentsPerUnit;
-        double perUnitCountDouble = convertedPerUnit.perUnitCount;
-        
-        ssPerUnitColumn << "@ $" << std::put_money(priceCentsPerUnit);
-        ssPerUnitColumn << " / ";
+    for (std::string line; getline(file, line);) {
+        // Skip empty lines.
+        if (line.empty()) {
+            continue;
+        }
         
-        if (isWhole(perUnitCountDouble)) {
-            if (perUnitCountDouble > 1) {
-                ssPerUnitColumn << static_cast<int64_t>(perUnitCountDouble) << " ";
+        if (startsWith(line, "//")) {
+            std::optional<std::string> sectionOpt = options.useSections ? parseSectionHeader(line) : std::nullopt;
+            
+            // Skip comments.
+            if (!sectionOpt.has_value()) {
+                continue;
+            }
+            
+            if (!section.empty()) {
+                printSectionSubtotal(sectionTotalPriceCents);
             }
-        } else {
-            ssPerUnitColumn << toPrecision(perUnitCountDouble, 2) << " ";
+            
+            if (hasOutput) {
+                // Separate the section from the previous one.
+                std::cout << std::endl;
+            }
+            
+            section = std::move(*sectionOpt);
+            sectionTotalPriceCents = 0;
+            hasOutput = true;
+            std::cout << section << std::endl;
+            continue;
         }
         
-        ssPerUnitColumn << convertCountTypeToString(perUnitCountType);
-        ssPerUnitColumn << ".";
-    } else {
-        // This is a quantity
-        if (perUnitCount != 1) {
-            ssPerUnitColumn << "@ " << perUnitCount;
-            ssPerUnitColumn << " / ";
-            ssPerUnitColumn << "$" << std::put_money(priceCentsPerUnit);
-        } else {
-            ssPerUnitColumn << "@ $" << std::put_money(priceCentsPerUnit);
-            ssPerUnitColumn << " / ";
-            ssPerUnitColumn << convertCountTypeToString(perUnitCountType);
-            ssPerUnitColumn << ".";
+        try {
+            ShoppingListItem shoppingListItem = parseShoppingListItemStr(line);
+            int64_t itemTotalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
+            
+            sectionTotals.add(section, itemTotalPriceCents);
+            sectionTotalPriceCents += itemTotalPriceCents;
+            totalPriceCents += itemTotalPriceCents;
+            printReportRow(options.reportTemplate, shoppingListItem, totalPriceCents);
+            hasOutput = true;
+        } catch (std::runtime_error& e) {
+            std::cerr << "Failed to parse line \"" << line << "\": " << e.what() << "; ignoring" << std::endl;
+            // Ignore errors and continue to the next line.
         }
     }
     
-    printPriceElement(itemTotalPriceCents, 8, separator);
-    printElement(ssPerUnitColumn.str(), 24, separator);
+    if (!section.empty()) {
+        printSectionSubtotal(sectionTotalPriceCents);
+    }
     
-    std::cout << std::endl;
+    return totalPriceCents;
 }
@@ -16,10 +16,25 @@
 #include <iomanip>
 #include <optional>
 #include <cmath>
+#include <string>
 #include "unit.h"
 #include "utils.h"
 #include "shopping_list.h"
+#include "section.h"
+#include "format.h"
+#include "report_template.h"
 
-void printShoppingListItem(ShoppingListItem shoppingListItem, Unit preferredUnit);
+/// Options for printing a shopping list file to the console.
+struct PrintOptions {
+    /// The compiled layout of each row, e.g. from compileConsoleTemplate.
+    ReportTemplate reportTemplate;
+    /// Whether header comments such as "// Produce" start sections.
+    bool useSections;
+};
+
+ReportTemplate compileConsoleTemplate(const std::string_view &templateStr, Unit preferredUnit);
+void printReportRow(const ReportTemplate &reportTemplate, const ShoppingListItem &shoppingListItem, int64_t runningTotalCents = 0);
+void printShoppingListItem(ShoppingListItem shoppingListItem, Unit preferredUnit, std::optional<int64_t> runningTotalCents = std::nullopt);
+int64_t printShoppingListFile(const std::string &filePath, const PrintOptions &options, SectionTotals &sectionTotals);
 
 #endif
@@ -0,0 +1,191 @@
+/**
+ * @file display_width.cpp
+ * @author Julia
+ * @brief Implements functions for measuring how many terminal columns text takes up.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include "utils.h"
+#include "display_width.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/// An inclusive range of code points.
+struct CodePointRange {
+    /// The first code point in the range.
+    uint32_t first;
+    /// The last code point in the range.
+    uint32_t last;
+};
+
+/// Combining marks, zero-width characters and variation selectors, which take up no columns.
+/// Sorted and non-overlapping.
+const CodePointRange ZERO_WIDTH_RANGES[] = {
+    {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD}, {0x05BF, 0x05BF}, {0x05C1, 0x05C2},
+    {0x05C4, 0x05C5}, {0x05C7, 0x05C7}, {0x0610, 0x061A}, {0x064B, 0x065F}, {0x0670, 0x0670},
+    {0x06D6, 0x06DC}, {0x06DF, 0x06E4}, {0x06E7, 0x06E8}, {0x06EA, 0x06ED}, {0x0900, 0x0902},
+    {0x093A, 0x093A}, {0x093C, 0x093C}, {0x0941, 0x0948}, {0x094D, 0x094D}, {0x0951, 0x0957},
+    {0x0962, 0x0963}, {0x0E31, 0x0E31}, {0x0E34, 0x0E3A}, {0x0E47, 0x0E4E}, {0x1AB0, 0x1AFF},
+    {0x1DC0, 0x1DFF}, {0x200B, 0x200F}, {0x202A, 0x202E}, {0x2060, 0x2064}, {0x20D0, 0x20FF},
+    {0x302A, 0x302D}, {0x3099, 0x309A}, {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F}, {0xFEFF, 0xFEFF},
+    {0x1F3FB, 0x1F3FF}, {0xE0001, 0xE0001}, {0xE0020, 0xE007F}, {0xE0100, 0xE01EF},
+};
+
+/// East Asian wide and full-width characters and emoji, which take up two columns. Sorted and
+/// non-overlapping. Zero-width ranges are checked first, so they may fall inside these.
+const CodePointRange WIDE_RANGES[] = {
+    {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2329, 0x232A}, {0x23E9, 0x23EC}, {0x23F0, 0x23F0},
+    {0x23F3, 0x23F3}, {0x25FD, 0x25FE}, {0x2614, 0x2615}, {0x2648, 0x2653}, {0x267F, 0x267F},
+    {0x2693, 0x2693}, {0x26A1, 0x26A1}, {0x26AA, 0x26AB}, {0x26BD, 0x26BE}, {0x26C4, 0x26C5},
+    {0x26CE, 0x26CE}, {0x26D4, 0x26D4}, {0x26EA, 0x26EA}, {0x26F2, 0x26F3}, {0x26F5, 0x26F5},
+    {0x26FA, 0x26FA}, {0x26FD, 0x26FD}, {0x2705, 0x2705}, {0x270A, 0x270B}, {0x2728, 0x2728},
+    {0x274C, 0x274C}, {0x274E, 0x274E}, {0x2753, 0x2755}, {0x2757, 0x2757}, {0x2795, 0x2797},
+    {0x27B0, 0x27B0}, {0x27BF, 0x27BF}, {0x2B1B, 0x2B1C}, {0x2B50, 0x2B50}, {0x2B55, 0x2B55},
+    {0x2E80, 0x303E}, {0x3041, 0x33FF}, {0x3400, 0x4DBF}, {0x4E00, 0x9FFF}, {0xA000, 0xA4CF},
+    {0xA960, 0xA97F}, {0xAC00, 0xD7A3}, {0xF900, 0xFAFF}, {0xFE10, 0xFE19}, {0xFE30, 0xFE6F},
+    {0xFF00, 0xFF60}, {0xFFE0, 0xFFE6}, {0x16FE0, 0x16FE4}, {0x17000, 0x187F7}, {0x18800, 0x18CD5},
+    {0x1B000, 0x1B2FF}, {0x1F004, 0x1F004}, {0x1F0CF, 0x1F0CF}, {0x1F18E, 0x1F18E}, {0x1F191, 0x1F19A},
+    {0x1F200, 0x1F202}, {0x1F210, 0x1F23B}, {0x1F240, 0x1F248}, {0x1F250, 0x1F251}, {0x1F260, 0x1F265},
+    {0x1F300, 0x1F64F}, {0x1F680, 0x1F6FF}, {0x1F7E0, 0x1F7EB}, {0x1F90C, 0x1F9FF}, {0x1FA70, 0x1FAFF},
+    {0x20000, 0x2FFFD}, {0x30000, 0x3FFFD},
+};
+
+/**
+ * @brief Checks whether a code point is in a table of ranges.
+ * 
+ * @tparam N The number of ranges.
+ * @param ranges The sorted ranges.
+ * @param codePoint The code point.
+ * @return True if a range contains the code point, false otherwise.
+ */
+template<size_t N>
+bool isInRanges(const CodePointRange (&ranges)[N], uint32_t codePoint) {
+    // Find the last range that starts at or before the code point.
+    const CodePointRange *it = std::upper_bound(std::begin(ranges), std::end(ranges), codePoint, [](uint32_t value, const CodePointRange &range) {
+        return value < range.first;
+    });
+    
+    return it != std::begin(ranges) && codePoint <= (it - 1)->last;
+}
+
+/**
+ * @brief Gets the number of terminal columns a code point takes up.
+ * 
+ * @param codePoint The code point.
+ * @return 0 for combining and zero-width characters, 2 for wide characters, otherwise 1.
+ */
+uint32_t getCodePointWidth(uint32_t codePoint) {
+    // Nothing before the combining diacritical marks is zero-width or wide.
+    if (codePoint < 0x0300) {
+        return 1;
+    }
+    
+    if (isInRanges(ZERO_WIDTH_RANGES, codePoint)) {
+        return 0;
+    }
+    
+    if (isInRanges(WIDE_RANGES, codePoint)) {
+        return 2;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief Decodes the UTF-8 character at the front of a string.
+ * 
+ * @param s The string, which must not be empty.
+ * @param codePoint The decoded code point.
+ * @return The length of the character, or 0 if it is not valid UTF-8.
+ */
+size_t decodeCodePoint(const std::string_view &s, uint32_t &codePoint) {
+    unsigned char lead = static_cast<unsigned char>(s[0]);
+    size_t charLen = getCharLen(s[0]);
+    
+    if (charLen == 1 || charLen > s.length()) {
+        return lead < 0x80 ? 1 : 0;
+    }
+    
+    codePoint = lead & (0x7f >> charLen);
+    
+    for (size_t i = 1; i < charLen; ++i) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        
+        if ((c & 0xc0) != 0x80) {
+            return 0;
+        }
+        
+        codePoint = codePoint << 6 | (c & 0x3f);
+    }
+    
+    return charLen;
+}
+
+/**
+ * @brief Gets the number of terminal columns a UTF-8 string takes up.
+ * 
+ * ASCII text is measured 16 bytes at a time where SSE2 is available, and every ASCII byte takes
+ * up one column. Other characters are looked up in small tables of zero-width and wide ranges.
+ * Bytes that are not valid UTF-8 take up one column each.
+ * 
+ * @param s The string.
+ * @return The number of columns.
+ */
+size_t getDisplayWidth(const std::string_view &s) {
+    size_t width = 0;
+    size_t i = 0;
+    
+    while (i < s.length()) {
+#if defined(__SSE2__)
+        // Skip runs of ASCII 16 bytes at a time. The high bit of every byte is clear.
+        while (i + 16 <= s.length()) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s.data() + i));
+            uint32_t nonAsciiMask = _mm_movemask_epi8(chunk);
+            
+            if (nonAsciiMask != 0) {
+                size_t asciiCount = __builtin_ctz(nonAsciiMask);
+                
+                width += asciiCount;
+                i += asciiCount;
+                break;
+            }
+            
+            width += 16;
+            i += 16;
+        }
+        
+        if (i >= s.length()) {
+            break;
+        }
+#endif
+
+        if (static_cast<unsigned char>(s[i]) < 0x80) {
+            width++;
+            i++;
+            continue;
+        }
+        
+        uint32_t codePoint = 0;
+        size_t charLen = decodeCodePoint(s.substr(i), codePoint);
+        
+        if (charLen == 0) {
+            width++;
+            i++;
+            continue;
+        }
+        
+        width += getCodePointWidth(codePoint);
+        i += charLen;
+    }
+    
+    return width;
+}
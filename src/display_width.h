@@ -0,0 +1,21 @@
+/**
+ * @file display_width.h
+ * @author Julia
+ * @brief Declares functions for measuring how many terminal columns text takes up.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef DISPLAY_WIDTH_H
+#define DISPLAY_WIDTH_H
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+uint32_t getCodePointWidth(uint32_t codePoint);
+size_t getDisplayWidth(const std::string_view &s);
+
+#endif
@@ -0,0 +1,304 @@
+/**
+ * @file editable_list.cpp
+ * @author Julia
+ * @brief Implements a shopping list that can be edited one line at a time.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include "unit.h"
+#include "format.h"
+#include "shopping_list.h"
+#include "report_template.h"
+#include "editable_list.h"
+
+/**
+ * @brief Compiles the template for the rendered rows of a list.
+ * 
+ * @param templateStr The report template.
+ * @param preferredUnit The preferred unit of measurement.
+ * @return The compiled template, padded by terminal columns so accented and wide names line up.
+ */
+static ReportTemplate compileListRowTemplate(const std::string_view &templateStr, Unit preferredUnit) {
+    ReportTemplate reportTemplate = compileReportTemplate(templateStr, preferredUnit, MoneyFormat::Grouped);
+    
+    reportTemplate.layout = ColumnLayout::DisplayWidth;
+    
+    return reportTemplate;
+}
+
+/**
+ * @brief Creates an empty list.
+ * 
+ * @param preferredUnit The preferred unit of measurement for rendered rows.
+ * @param templateStr The report template for rendered rows.
+ */
+ShoppingList::ShoppingList(Unit preferredUnit, const std::string_view &templateStr) :
+    reportTemplate(compileListRowTemplate(templateStr, preferredUnit)) {}
+
+/**
+ * @brief Gets the slot for a handle.
+ * 
+ * @param handle The handle.
+ * @return The slot.
+ */
+ShoppingList::Slot &ShoppingList::getSlot(ItemHandle handle) {
+    if (
+        handle.index >= slots.size() ||
+        !slots[handle.index].isOccupied ||
+        slots[handle.index].generation != handle.generation
+    ) {
+        throw std::runtime_error("Invalid item handle");
+    }
+    
+    return slots[handle.index];
+}
+
+/**
+ * @brief Gets the slot for a handle.
+ * 
+ * @param handle The handle.
+ * @return The slot.
+ */
+const ShoppingList::Slot &ShoppingList::getSlot(ItemHandle handle) const {
+    return const_cast<ShoppingList *>(this)->getSlot(handle);
+}
+
+/**
+ * @brief Parses a line and adds it to the end of the list.
+ * 
+ * Throws if the line cannot be parsed, leaving the list unchanged.
+ * 
+ * @param line The shopping list line.
+ * @return A handle to the new item.
+ */
+ItemHandle ShoppingList::insert(const std::string &line) {
+    return link(line, NO_SLOT);
+}
+
+/**
+ * @brief Parses a line and adds it to the list just before another item.
+ * 
+ * Throws if the line cannot be parsed or the handle is invalid, leaving the list unchanged.
+ * 
+ * @param before The handle of the item the new item goes before.
+ * @param line The shopping list line.
+ * @return A handle to the new item.
+ */
+ItemHandle ShoppingList::insertBefore(ItemHandle before, const std::string &line) {
+    getSlot(before);
+    
+    return link(line, before.index);
+}
+
+/**
+ * @brief Parses a line into a free slot and links it into the list.
+ * 
+ * @param line The shopping list line.
+ * @param next The slot the new item goes before, or NO_SLOT to add it to the end.
+ * @return A handle to the new item.
+ */
+ItemHandle ShoppingList::link(const std::string &line, uint32_t next) {
+    ShoppingListItem shoppingListItem = parseShoppingListItemStr(line);
+    int64_t itemTotalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
+    uint32_t index;
+    
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots.size());
+        slots.push_back(Slot {
+            .item = ShoppingListItem {},
+            .totalPriceCents = 0,
+            .renderedRow = "",
+            .isRowValid = false,
+            .isOccupied = false,
+            .generation = 0,
+            .prev = NO_SLOT,
+            .next = NO_SLOT,
+        });
+    }
+    
+    Slot &slot = slots[index];
+    uint32_t prev = next != NO_SLOT ? slots[next].prev : tail;
+    
+    slot.item = std::move(shoppingListItem);
+    slot.totalPriceCents = itemTotalPriceCents;
+    slot.isRowValid = false;
+    slot.isOccupied = true;
+    slot.prev = prev;
+    slot.next = next;
+    
+    // Link the slot between its neighbours.
+    if (prev != NO_SLOT) {
+        slots[prev].next = index;
+    } else {
+        head = index;
+    }
+    
+    if (next != NO_SLOT) {
+        slots[next].prev = index;
+    } else {
+        tail = index;
+    }
+    
+    itemCount++;
+    totalPriceCents += itemTotalPriceCents;
+    
+    return ItemHandle {
+        .index = index,
+        .generation = slot.generation,
+    };
+}
+
+/**
+ * @brief Replaces an item by parsing a new line for it.
+ * 
+ * Only the edited line is parsed and the total is adjusted by the difference in price. Throws if
+ * the line cannot be parsed, leaving the list unchanged.
+ * 
+ * @param handle The handle of the item.
+ * @param line The new shopping list line.
+ */
+void ShoppingList::update(ItemHandle handle, const std::string &line) {
+    Slot &slot = getSlot(handle);
+    ShoppingListItem shoppingListItem = parseShoppingListItemStr(line);
+    int64_t itemTotalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
+    
+    totalPriceCents += itemTotalPriceCents - slot.totalPriceCents;
+    slot.item = std::move(shoppingListItem);
+    slot.totalPriceCents = itemTotalPriceCents;
+    slot.isRowValid = false;
+}
+
+/**
+ * @brief Removes an item.
+ * 
+ * @param handle The handle of the item. Invalid afterwards.
+ */
+void ShoppingList::erase(ItemHandle handle) {
+    Slot &slot = getSlot(handle);
+    
+    // Unlink the slot.
+    if (slot.prev != NO_SLOT) {
+        slots[slot.prev].next = slot.next;
+    } else {
+        head = slot.next;
+    }
+    
+    if (slot.next != NO_SLOT) {
+        slots[slot.next].prev = slot.prev;
+    } else {
+        tail = slot.prev;
+    }
+    
+    totalPriceCents -= slot.totalPriceCents;
+    itemCount--;
+    
+    slot.isOccupied = false;
+    slot.generation++;
+    slot.renderedRow.clear();
+    freeSlots.push_back(handle.index);
+}
+
+/**
+ * @brief Gets an item.
+ * 
+ * @param handle The handle of the item.
+ * @return The item.
+ */
+const ShoppingListItem &ShoppingList::get(ItemHandle handle) const {
+    return getSlot(handle).item;
+}
+
+/**
+ * @brief Gets the rendered row for an item, rendering it only if it has changed.
+ * 
+ * @param handle The handle of the item.
+ * @return The rendered row, including the newline.
+ */
+const std::string &ShoppingList::getRenderedRow(ItemHandle handle) {
+    Slot &slot = getSlot(handle);
+    
+    if (!slot.isRowValid) {
+        slot.renderedRow.clear();
+        renderReportRow(reportTemplate, slot.item, slot.renderedRow);
+        slot.isRowValid = true;
+    }
+    
+    return slot.renderedRow;
+}
+
+/**
+ * @brief Gets handles to every item in list order.
+ * 
+ * @return The handles.
+ */
+std::vector<ItemHandle> ShoppingList::getHandles() const {
+    std::vector<ItemHandle> handles;
+    
+    handles.reserve(itemCount);
+    
+    for (uint32_t index = head; index != NO_SLOT; index = slots[index].next) {
+        handles.push_back(ItemHandle {
+            .index = index,
+            .generation = slots[index].generation,
+        });
+    }
+    
+    return handles;
+}
+
+/**
+ * @brief Renders every item in list order, reusing cached rows.
+ * 
+ * An edit changes the running total of every row after it, so templates with a running total
+ * column render every row again.
+ * 
+ * @param out The output to append the rows to.
+ */
+void ShoppingList::render(std::string &out) {
+    if (hasRunningTotal(reportTemplate)) {
+        int64_t runningTotalCents = 0;
+        
+        for (uint32_t index = head; index != NO_SLOT; index = slots[index].next) {
+            runningTotalCents += getShoppingListItemTotalPrice(slots[index].item);
+            renderReportRow(reportTemplate, slots[index].item, out, runningTotalCents);
+        }
+        
+        return;
+    }
+    
+    for (uint32_t index = head; index != NO_SLOT; index = slots[index].next) {
+        out += getRenderedRow(ItemHandle {
+            .index = index,
+            .generation = slots[index].generation,
+        });
+    }
+}
+
+/**
+ * @brief Gets the total price of all items.
+ * 
+ * @return The total price in cents.
+ */
+int64_t ShoppingList::getTotalPriceCents() const {
+    return totalPriceCents;
+}
+
+/**
+ * @brief Gets the number of items.
+ * 
+ * @return The number of items.
+ */
+size_t ShoppingList::size() const {
+    return itemCount;
+}
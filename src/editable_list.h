@@ -0,0 +1,92 @@
+/**
+ * @file editable_list.h
+ * @author Julia
+ * @brief Declares a shopping list that can be edited one line at a time.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef EDITABLE_LIST_H
+#define EDITABLE_LIST_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "unit.h"
+#include "shopping_list.h"
+#include "report_template.h"
+
+/// A stable reference to an item in a shopping list. Stays valid until the item is erased.
+struct ItemHandle {
+    /// The slot of the item.
+    uint32_t index;
+    /// The generation of the slot when the handle was created.
+    uint32_t generation;
+};
+
+/// A shopping list that keeps its total and rendered rows up to date as lines are edited.
+class ShoppingList {
+public:
+    ShoppingList(Unit preferredUnit = Unit::Pound, const std::string_view &templateStr = DEFAULT_REPORT_TEMPLATE);
+    
+    ItemHandle insert(const std::string &line);
+    ItemHandle insertBefore(ItemHandle before, const std::string &line);
+    void update(ItemHandle handle, const std::string &line);
+    void erase(ItemHandle handle);
+    const ShoppingListItem &get(ItemHandle handle) const;
+    const std::string &getRenderedRow(ItemHandle handle);
+    std::vector<ItemHandle> getHandles() const;
+    void render(std::string &out);
+    int64_t getTotalPriceCents() const;
+    size_t size() const;
+
+private:
+    /// Marks the end of the linked list of slots.
+    static const uint32_t NO_SLOT = UINT32_MAX;
+    
+    /// Storage for one item.
+    struct Slot {
+        /// The parsed item.
+        ShoppingListItem item;
+        /// The total price of the item in cents.
+        int64_t totalPriceCents;
+        /// The cached rendered row.
+        std::string renderedRow;
+        /// Whether the cached row is up to date.
+        bool isRowValid;
+        /// Whether the slot holds an item.
+        bool isOccupied;
+        /// Incremented each time the slot is freed so old handles are rejected.
+        uint32_t generation;
+        /// The previous item in list order.
+        uint32_t prev;
+        /// The next item in list order.
+        uint32_t next;
+    };
+    
+    ItemHandle link(const std::string &line, uint32_t next);
+    Slot &getSlot(ItemHandle handle);
+    const Slot &getSlot(ItemHandle handle) const;
+    
+    /// The compiled template for rendering rows.
+    ReportTemplate reportTemplate;
+    /// The item storage. Handles hold an index rather than a pointer since the slots move when the
+    /// vector grows, and erased slots are reused for new items.
+    std::vector<Slot> slots;
+    /// Slots that have been freed and can be reused.
+    std::vector<uint32_t> freeSlots;
+    /// The first item in list order.
+    uint32_t head = NO_SLOT;
+    /// The last item in list order.
+    uint32_t tail = NO_SLOT;
+    /// The number of items.
+    size_t itemCount = 0;
+    /// The total price of all items in cents.
+    int64_t totalPriceCents = 0;
+};
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file export.cpp
+ * @author Julia
+ * @brief Implements exporting reports to a file from several threads.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "shopping_list.h"
+#include "report_template.h"
+#include "buffered_writer.h"
+#include "parallel.h"
+#include "gzip_writer.h"
+#include "running_total.h"
+#include "export.h"
+
+/// The number of items rendered by a worker at a time.
+size_t const EXPORT_CHUNK_SIZE = 4096;
+
+/**
+ * @brief Writes a report to a file, rendering and writing chunks of rows on several threads.
+ * 
+ * In the first pass each worker renders chunks of rows and records their byte sizes. A prefix sum
+ * over the sizes gives every chunk its offset in the file, which is sized up front. In the second
+ * pass each worker writes its chunks to their offsets with pwrite, so no worker waits on another.
+ * The file is byte-identical to the output of renderReport.
+ * 
+ * @param filePath The path to the file to write. It is replaced if it exists.
+ * @param reportTemplate The compiled template.
+ * @param shoppingListItems The shopping list items.
+ * @param threadCount The number of threads.
+ */
+void exportReport(
+    const std::string &filePath,
+    const ReportTemplate &reportTemplate,
+    const std::vector<ShoppingListItem> &shoppingListItems,
+    size_t threadCount
+) {
+    size_t chunkCount = (shoppingListItems.size() + EXPORT_CHUNK_SIZE - 1) / EXPORT_CHUNK_SIZE;
+    std::vector<std::string> chunks = std::vector<std::string>(chunkCount);
+    
+    threadCount = std::max<size_t>(1, threadCount);
+    
+    std::vector<int64_t> runningTotals;
+    
+    if (hasRunningTotal(reportTemplate)) {
+        runningTotals = computeRunningTotals(shoppingListItems, threadCount);
+    }
+    
+    ReportTemplate fitted = fitReportTemplate(reportTemplate, shoppingListItems, runningTotals, threadCount);
+    
+    // Render every chunk to learn its size.
+    forEachChunk(chunkCount, threadCount, [&](size_t chunkIndex) {
+        size_t start = chunkIndex * EXPORT_CHUNK_SIZE;
+        size_t end = std::min(start + EXPORT_CHUNK_SIZE, shoppingListItems.size());
+        
+        for (size_t i = start; i < end; ++i) {
+            int64_t runningTotalCents = runningTotals.empty() ? 0 : runningTotals[i];
+            
+            renderReportRow(fitted, shoppingListItems[i], chunks[chunkIndex], runningTotalCents);
+        }
+    });
+    
+    // The offset of each chunk is the sum of the sizes before it.
+    std::vector<uint64_t> offsets = std::vector<uint64_t>(chunkCount + 1, 0);
+    
+    for (size_t i = 0; i < chunkCount; ++i) {
+        offsets[i + 1] = offsets[i] + chunks[i].length();
+    }
+    
+    int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open \"" + filePath + "\"");
+    }
+    
+    try {
+        if (::ftruncate(fd, static_cast<off_t>(offsets[chunkCount])) != 0) {
+            throw std::runtime_error("Failed to size \"" + filePath + "\"");
+        }
+        
+        // Write every chunk to its own region of the file.
+        forEachChunk(chunkCount, threadCount, [&](size_t chunkIndex) {
+            pwriteAll(fd, chunks[chunkIndex], offsets[chunkIndex]);
+            // Free the chunk as soon as it is written.
+            std::string().swap(chunks[chunkIndex]);
+        });
+    } catch (std::runtime_error& e) {
+        ::close(fd);
+        throw;
+    }
+    
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to close \"" + filePath + "\"");
+    }
+}
+
+/**
+ * @brief Writes a gzip-compressed report to a file, compressing blocks on several threads.
+ * 
+ * Rows are rendered into a buffer that feeds the compressor directly, so the uncompressed report
+ * is never stored in full.
+ * 
+ * @param filePath The path to the file to write. It is replaced if it exists.
+ * @param reportTemplate The compiled template.
+ * @param shoppingListItems The shopping list items.
+ * @param threadCount The number of threads.
+ */
+void exportCompressedReport(
+    const std::string &filePath,
+    const ReportTemplate &reportTemplate,
+    const std::vector<ShoppingListItem> &shoppingListItems,
+    size_t threadCount
+) {
+    int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open \"" + filePath + "\"");
+    }
+    
+    try {
+        ParallelGzipWriter gzipWriter = ParallelGzipWriter(fd, threadCount);
+        BufferedWriter writer = BufferedWriter([&](const std::string_view &s) {
+            gzipWriter.append(s);
+        });
+        
+        renderReport(reportTemplate, shoppingListItems, writer, threadCount);
+        writer.flush();
+        gzipWriter.finish();
+    } catch (std::runtime_error& e) {
+        ::close(fd);
+        throw;
+    }
+    
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to close \"" + filePath + "\"");
+    }
+}
@@ -0,0 +1,33 @@
+/**
+ * @file export.h
+ * @author Julia
+ * @brief Declares exporting reports to a file from several threads.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef EXPORT_H
+#define EXPORT_H
+#pragma once
+
+#include <string>
+#include <vector>
+#include "shopping_list.h"
+#include "report_template.h"
+
+void exportReport(
+    const std::string &filePath,
+    const ReportTemplate &reportTemplate,
+    const std::vector<ShoppingListItem> &shoppingListItems,
+    size_t threadCount
+);
+void exportCompressedReport(
+    const std::string &filePath,
+    const ReportTemplate &reportTemplate,
+    const std::vector<ShoppingListItem> &shoppingListItems,
+    size_t threadCount
+);
+
+#endif
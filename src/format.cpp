@@ -0,0 +1,276 @@
+/**
+ * @file format.cpp
+ * @author Julia
+ * @brief Formats the columns of shopping list items without output streams.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * Kept apart from display.cpp so the lean program can format rows without linking <iostream>. The
+ * locale formats are in format_locale.cpp, which the lean program replaces with lean/format_locale.cpp.
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <optional>
+#include <string>
+#include "unit.h"
+#include "utils.h"
+#include "shopping_list.h"
+#include "format.h"
+
+/**
+ * @brief Converts a weight to a displayable weight.
+ * 
+ * @param weight The weight.
+ * @param unit The unit of measurement.
+ * @return The displayable weight.
+ */
+double displayWeight(double weight, Unit unit) {
+    if (isWhole(weight)) {
+        // This is a whole number
+        return weight;
+    }
+    
+    switch (unit) {
+        case Unit::Ounce:
+            // Convert to 1 decimal place
+            return std::round(weight * 10.0) / 10.0;
+        case Unit::Pound:
+            // Convert to 2 decimal places
+            return std::round(weight * 100.0) / 100.0;
+        case Unit::Kilogram:    
+            // Convert to 2 decimal places
+            return std::round(weight * 100.0) / 100.0;
+        case Unit::Gram:
+            return std::round(weight);
+    }
+    // Removes compiler warning about unreachable code.
+     __builtin_unreachable();
+}
+
+/// Converted price per unit result.
+struct ConvertedPerUnit {
+    // The count of the unit.
+    double perUnitCount;
+    /// The unit for the price per unit.
+    Unit perUnitUnit;
+    /// The price of the item in cents, per unit.
+    int64_t priceCentsPerUnit;
+};
+
+/**
+ * @brief Calculate the conversion for the per unit.
+ * 
+ * @param perUnitCount The count of the unit.
+ * @param unit The unit.
+ * @param priceCentsPerUnit The price of the item in cents, per unit. 
+ * @param preferredUnit The preferred unit.
+ * @return The converted per unit. 
+ */
+ConvertedPerUnit calculateConvertedPerUnit(int64_t perUnitCount, Unit unit, int64_t priceCentsPerUnit, Unit preferredUnit) {
+    System system = getUnitSystem(unit);
+    System preferredSystem = getUnitSystem(preferredUnit);
+    double preferredPerUnitCount = static_cast<double>(perUnitCount);
+    
+    if (system == preferredSystem) {
+        // The unit is in the same system as the preferred unit.
+        return ConvertedPerUnit {
+            .perUnitCount = preferredPerUnitCount,
+            .perUnitUnit = unit,
+            .priceCentsPerUnit = priceCentsPerUnit,
+        };
+    }
+    
+    switch (unit) {
+        case Unit::Ounce:
+        case Unit::Pound:
+            preferredUnit = Unit::Kilogram;
+            break;
+        case Unit::Kilogram:
+        case Unit::Gram:
+            preferredUnit = Unit::Pound;
+            break;
+    }
+    
+    double convertedUnitCount = convertWeight(static_cast<double>(perUnitCount), unit, preferredUnit);
+    int64_t newPriceCentsPerUnit = priceCentsPerUnit;
+    
+    if (perUnitCount > 1) {
+        // We don't adjust the price but we do adjust the unit count.
+        preferredPerUnitCount = convertedUnitCount;
+    } else {
+        // Get the ratio between the new unit count and the original unit count.
+        double perUnitCountRatio = preferredPerUnitCount / static_cast<double>(convertedUnitCount);
+        // Calculate the new price per unit.
+        newPriceCentsPerUnit = static_cast<int64_t>(priceCentsPerUnit * perUnitCountRatio);
+    }
+    
+    return ConvertedPerUnit {
+        .perUnitCount = preferredPerUnitCount,
+        .perUnitUnit = preferredUnit,
+        .priceCentsPerUnit = newPriceCentsPerUnit,
+    };
+}
+
+/**
+ * @brief Formats a number the way an output stream does by default, without a stream.
+ * 
+ * @param value The number.
+ * @param moneyFormat The format of the column. Locale groups digits the way the locale does.
+ * @return The formatted number.
+ */
+static std::string formatNumber(double value, MoneyFormat moneyFormat = MoneyFormat::Plain) {
+    if (moneyFormat == MoneyFormat::Locale) {
+        return formatLocaleNumber(value);
+    }
+    
+    // Streams print doubles with "%g" and 6 significant digits.
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+/**
+ * @brief Formats a whole number the way an output stream does by default, without a stream.
+ * 
+ * @param value The number.
+ * @param moneyFormat The format of the column. Locale groups digits the way the locale does.
+ * @return The formatted number.
+ */
+static std::string formatNumber(int64_t value, MoneyFormat moneyFormat = MoneyFormat::Plain) {
+    if (moneyFormat == MoneyFormat::Locale) {
+        return formatLocaleNumber(value);
+    }
+    
+    return std::to_string(value);
+}
+
+/**
+ * @brief Formats an amount of money without a currency symbol.
+ * 
+ * @param cents The amount in cents.
+ * @param moneyFormat The format to use.
+ * @return The formatted amount.
+ */
+std::string formatMoney(int64_t cents, MoneyFormat moneyFormat) {
+    if (moneyFormat == MoneyFormat::Locale) {
+        return formatLocaleMoney(cents);
+    }
+    
+    if (moneyFormat == MoneyFormat::Cents) {
+        return std::to_string(cents);
+    }
+    
+    uint64_t absCents = cents < 0 ? -static_cast<uint64_t>(cents) : static_cast<uint64_t>(cents);
+    std::string dollars = std::to_string(absCents / 100);
+    uint64_t remainderCents = absCents % 100;
+    std::string formatted = cents < 0 ? "-" : "";
+    
+    if (moneyFormat == MoneyFormat::Grouped) {
+        // Insert a comma before every group of three digits, as the en_US locale does.
+        for (size_t i = 0; i < dollars.length(); ++i) {
+            if (i > 0 && (dollars.length() - i) % 3 == 0) {
+                formatted += ',';
+            }
+            
+            formatted += dollars[i];
+        }
+    } else {
+        formatted += dollars;
+    }
+    
+    formatted += '.';
+    formatted += static_cast<char>('0' + remainderCents / 10);
+    formatted += static_cast<char>('0' + remainderCents % 10);
+    
+    return formatted;
+}
+
+/**
+ * @brief Formats the count column of a shopping list item, e.g. "2 lb.".
+ * 
+ * @param shoppingListItem The shopping list item.
+ * @param preferredUnit The preferred unit of measurement.
+ * @return The formatted count.
+ */
+std::string formatCountColumn(const ShoppingListItem &shoppingListItem, Unit preferredUnit) {
+    std::optional<Unit> unitOpt = convertCountTypeToUnit(shoppingListItem.countType);
+    
+    if (unitOpt.has_value()) {
+        // Convert the weight to preferred unit.
+        Unit unit = std::move(*unitOpt);
+        double weight = convertWeight(shoppingListItem.count, unit, preferredUnit);
+        std::string unitStr = convertUnitToString(preferredUnit);
+        
+        // Convert to a sensible precision for display.
+        return formatNumber(displayWeight(weight, preferredUnit)) + " " + unitStr + ".";
+    }
+    
+    // This is a quantity
+    return formatNumber(shoppingListItem.count);
+}
+
+/**
+ * @brief Formats the price per unit column of a shopping list item, e.g. "@ $4.99 / lb.".
+ * 
+ * @param shoppingListItem The shopping list item.
+ * @param preferredUnit The preferred unit of measurement.
+ * @param moneyFormat The format to use for prices.
+ * @return The formatted price per unit.
+ */
+std::string formatPerUnitColumn(const ShoppingListItem &shoppingListItem, Unit preferredUnit, MoneyFormat moneyFormat) {
+    std::optional<Unit> perUnitUnitOpt = convertCountTypeToUnit(shoppingListItem.perUnitCountType);
+    
+    int64_t priceCentsPerUnit = shoppingListItem.priceCentsPerUnit;
+    int64_t perUnitCount = shoppingListItem.perUnitCount;
+    CountType perUnitCountType = shoppingListItem.perUnitCountType;
+    
+    std::string perUnitColumn;
+    
+    if (perUnitUnitOpt.has_value()) {
+        Unit perUnitUnit = std::move(*perUnitUnitOpt);
+        ConvertedPerUnit convertedPerUnit = calculateConvertedPerUnit(
+            perUnitCount,
+            perUnitUnit,
+            priceCentsPerUnit,
+            preferredUnit
+        );
+        
+        perUnitCountType = convertUnitToCountType(convertedPerUnit.perUnitUnit);
+        priceCentsPerUnit = convertedPerUnit.priceCentsPerUnit;
+        double perUnitCountDouble = convertedPerUnit.perUnitCount;
+        
+        perUnitColumn += "@ $" + formatMoney(priceCentsPerUnit, moneyFormat);
+        perUnitColumn += " / ";
+        
+        if (isWhole(perUnitCountDouble)) {
+            if (perUnitCountDouble > 1) {
+                // Numbers are grouped by the locale as well as prices.
+                perUnitColumn += formatNumber(static_cast<int64_t>(perUnitCountDouble), moneyFormat) + " ";
+            }
+        } else {
+            perUnitColumn += formatNumber(toPrecision(perUnitCountDouble, 2), moneyFormat) + " ";
+        }
+        
+        perUnitColumn += convertCountTypeToString(perUnitCountType);
+        perUnitColumn += ".";
+    } else {
+        // This is a quantity
+        if (perUnitCount != 1) {
+            perUnitColumn += "@ " + formatNumber(perUnitCount, moneyFormat);
+            perUnitColumn += " / ";
+            perUnitColumn += "$" + formatMoney(priceCentsPerUnit, moneyFormat);
+        } else {
+            perUnitColumn += "@ $" + formatMoney(priceCentsPerUnit, moneyFormat);
+            perUnitColumn += " / ";
+            perUnitColumn += convertCountTypeToString(perUnitCountType);
+            perUnitColumn += ".";
+        }
+    }
+    
+    return perUnitColumn;
+}
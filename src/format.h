@@ -0,0 +1,42 @@
+/**
+ * @file format.h
+ * @author Julia
+ * @brief Declares functions that format the columns of shopping list items without output streams.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef FORMAT_H
+#define FORMAT_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "unit.h"
+#include "shopping_list.h"
+
+/// Formats for amounts of money.
+enum class MoneyFormat {
+    /// Formatted by the en_US locale, e.g. "1,234.56".
+    Locale,
+    /// Grouped by thousands without using a locale, e.g. "1,234.56".
+    Grouped,
+    /// Dollars and cents without grouping, e.g. "1234.56".
+    Plain,
+    /// A whole number of cents, e.g. "123456".
+    Cents
+};
+
+// Defined in format_locale.cpp, or in lean/format_locale.cpp for the lean program.
+std::string formatLocaleNumber(double value);
+std::string formatLocaleNumber(int64_t value);
+std::string formatLocaleMoney(int64_t cents);
+
+double displayWeight(double weight, Unit unit);
+std::string formatMoney(int64_t cents, MoneyFormat moneyFormat);
+std::string formatCountColumn(const ShoppingListItem &shoppingListItem, Unit preferredUnit);
+std::string formatPerUnitColumn(const ShoppingListItem &shoppingListItem, Unit preferredUnit, MoneyFormat moneyFormat);
+
+#endif
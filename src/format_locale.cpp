@@ -0,0 +1,61 @@
+/**
+ * @file format_locale.cpp
+ * @author Julia
+ * @brief Formats numbers and amounts of money with the en_US locale.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * Imbuing a stream with a locale pulls in <sstream> and <locale>, so these are kept out of
+ * format.cpp, which the lean program links.
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <locale>
+#include <iomanip>
+#include "format.h"
+
+/**
+ * @brief Formats a number the way an output stream with the en_US locale does.
+ * 
+ * @param value The number.
+ * @return The formatted number, with digits grouped by the locale.
+ */
+std::string formatLocaleNumber(double value) {
+    std::stringstream ss;
+    
+    ss.imbue(std::locale("en_US.UTF-8"));
+    ss << value;
+    return ss.str();
+}
+
+/**
+ * @brief Formats a whole number the way an output stream with the en_US locale does.
+ * 
+ * @param value The number.
+ * @return The formatted number, with digits grouped by the locale.
+ */
+std::string formatLocaleNumber(int64_t value) {
+    std::stringstream ss;
+    
+    ss.imbue(std::locale("en_US.UTF-8"));
+    ss << value;
+    return ss.str();
+}
+
+/**
+ * @brief Formats an amount of money with the en_US locale, without a currency symbol.
+ * 
+ * @param cents The amount in cents.
+ * @return The formatted amount, e.g. "1,234.56".
+ */
+std::string formatLocaleMoney(int64_t cents) {
+    std::stringstream ss;
+    
+    ss.imbue(std::locale("en_US.UTF-8"));
+    ss << std::put_money(cents);
+    return ss.str();
+}
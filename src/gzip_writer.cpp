@@ -0,0 +1,272 @@
+/**
+ * @file gzip_writer.cpp
+ * @author Julia
+ * @brief Implements a gzip writer that compresses blocks on worker threads.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+#include "binary_io.h"
+#include "buffered_writer.h"
+#include "gzip_writer.h"
+
+/// The size of the deflate window. Each block is primed with this much of the previous input.
+size_t const DEFLATE_WINDOW_SIZE = 32768;
+/// A gzip header with no file name or time, for deflate data from an unknown OS.
+const char GZIP_HEADER[] = {'\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\x03'};
+
+/**
+ * @brief Compresses a block as raw deflate data.
+ * 
+ * Blocks other than the last end with a sync flush, which pads the output to a byte boundary
+ * without ending the deflate stream, so the next block's output can follow it directly.
+ * 
+ * @param input The input.
+ * @param dictionary The input before the block, which the block may refer back to.
+ * @param isLast Whether this is the last block of the stream.
+ * @param level The zlib compression level.
+ * @return The compressed output.
+ */
+std::string deflateBlock(const std::string &input, const std::string &dictionary, bool isLast, int level) {
+    z_stream stream = {};
+    
+    if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("Failed to initialize zlib.");
+    }
+    
+    if (!dictionary.empty()) {
+        deflateSetDictionary(&stream, reinterpret_cast<const Bytef *>(dictionary.data()), static_cast<uInt>(dictionary.length()));
+    }
+    
+    // The bound covers the data; the flush marker and final block need a few more bytes.
+    std::string output = std::string(deflateBound(&stream, input.length()) + 16, '\0');
+    
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.length());
+    stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    stream.avail_out = static_cast<uInt>(output.length());
+    
+    int result = deflate(&stream, isLast ? Z_FINISH : Z_SYNC_FLUSH);
+    
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    
+    if (result != (isLast ? Z_STREAM_END : Z_OK) || stream.avail_in != 0) {
+        throw std::runtime_error("Failed to compress output.");
+    }
+    
+    return output;
+}
+
+/**
+ * @brief Creates a writer and writes the gzip header.
+ * 
+ * @param fd The file descriptor to write to. It is not closed by the writer.
+ * @param threadCount The number of threads to compress with.
+ * @param level The zlib compression level, from 1 (fastest) to 9 (smallest).
+ * @param blockSize The number of input bytes to compress as a block.
+ */
+ParallelGzipWriter::ParallelGzipWriter(int fd, size_t threadCount, int level, size_t blockSize) :
+    fd(fd),
+    level(level),
+    blockSize(std::max<size_t>(blockSize, DEFLATE_WINDOW_SIZE)),
+    crc(crc32(0, Z_NULL, 0)) {
+    writeAll(fd, std::string_view(GZIP_HEADER, sizeof(GZIP_HEADER)));
+    input.reserve(this->blockSize);
+    
+    for (size_t i = 0; i < std::max<size_t>(1, threadCount); ++i) {
+        workers.emplace_back(&ParallelGzipWriter::runWorker, this);
+    }
+}
+
+/**
+ * @brief Finishes the stream if it has not been finished.
+ */
+ParallelGzipWriter::~ParallelGzipWriter() {
+    try {
+        finish();
+    } catch (std::runtime_error& e) {
+        // Destructors must not throw. Call finish explicitly to handle errors.
+    }
+    
+    stopWorkers();
+}
+
+/**
+ * @brief Appends input to the stream. Full blocks are handed to the workers.
+ * 
+ * @param s The input.
+ */
+void ParallelGzipWriter::append(const std::string_view &s) {
+    if (isFinished) {
+        throw std::runtime_error("Cannot append to a finished gzip stream.");
+    }
+    
+    std::string_view remaining = s;
+    
+    while (!remaining.empty()) {
+        size_t length = std::min(remaining.length(), blockSize - input.length());
+        
+        input.append(remaining.data(), length);
+        remaining = remaining.substr(length);
+        
+        if (input.length() == blockSize) {
+            submitBlock(false);
+        }
+    }
+}
+
+/**
+ * @brief Compresses the remaining input and writes the rest of the stream and the gzip trailer.
+ */
+void ParallelGzipWriter::finish() {
+    if (isFinished) {
+        return;
+    }
+    
+    isFinished = true;
+    submitBlock(true);
+    
+    while (!pendingBlocks.empty()) {
+        writeNextBlock();
+    }
+    
+    std::string trailer;
+    
+    appendBinary(trailer, crc);
+    // The length is stored modulo 2^32.
+    appendBinary(trailer, static_cast<uint32_t>(inputLength));
+    writeAll(fd, trailer);
+    stopWorkers();
+}
+
+/**
+ * @brief Hands the current input to the workers as a block.
+ * 
+ * Writes finished blocks first if too many are waiting, so memory use stays bounded.
+ * 
+ * @param isLast Whether this is the last block of the stream.
+ */
+void ParallelGzipWriter::submitBlock(bool isLast) {
+    while (pendingBlocks.size() >= 2 * workers.size()) {
+        writeNextBlock();
+    }
+    
+    std::shared_ptr<Block> block = std::make_shared<Block>();
+    
+    block->input = std::move(input);
+    block->dictionary = std::move(previousTail);
+    block->isLast = isLast;
+    block->isDone = false;
+    
+    size_t tailLength = std::min(block->input.length(), DEFLATE_WINDOW_SIZE);
+    
+    previousTail = block->input.substr(block->input.length() - tailLength);
+    input = std::string();
+    input.reserve(blockSize);
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    pendingBlocks.push_back(block);
+    queuedBlocks.push_back(block);
+    queuedCondition.notify_one();
+}
+
+/**
+ * @brief Waits for the oldest block to be compressed and writes it.
+ */
+void ParallelGzipWriter::writeNextBlock() {
+    std::shared_ptr<Block> block = pendingBlocks.front();
+    
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        
+        doneCondition.wait(lock, [&]() {
+            return block->isDone;
+        });
+    }
+    
+    pendingBlocks.pop_front();
+    
+    if (!block->error.empty()) {
+        throw std::runtime_error(block->error);
+    }
+    
+    writeAll(fd, block->output);
+    crc = crc32_combine(crc, block->crc, static_cast<z_off_t>(block->input.length()));
+    inputLength += block->input.length();
+}
+
+/**
+ * @brief Compresses queued blocks until the writer stops.
+ */
+void ParallelGzipWriter::runWorker() {
+    while (true) {
+        std::shared_ptr<Block> block;
+        
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            
+            queuedCondition.wait(lock, [&]() {
+                return isStopping || !queuedBlocks.empty();
+            });
+            
+            if (queuedBlocks.empty()) {
+                return;
+            }
+            
+            block = queuedBlocks.front();
+            queuedBlocks.pop_front();
+        }
+        
+        std::string output;
+        std::string error;
+        uint32_t blockCrc = crc32(0, reinterpret_cast<const Bytef *>(block->input.data()), static_cast<uInt>(block->input.length()));
+        
+        try {
+            output = deflateBlock(block->input, block->dictionary, block->isLast, level);
+        } catch (std::runtime_error& e) {
+            error = e.what();
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        
+        block->output = std::move(output);
+        block->crc = blockCrc;
+        block->error = std::move(error);
+        block->isDone = true;
+        doneCondition.notify_all();
+    }
+}
+
+/**
+ * @brief Stops and joins the workers.
+ */
+void ParallelGzipWriter::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        
+        isStopping = true;
+        queuedCondition.notify_all();
+    }
+    
+    for (std::thread &worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
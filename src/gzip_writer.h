@@ -0,0 +1,95 @@
+/**
+ * @file gzip_writer.h
+ * @author Julia
+ * @brief Declares a gzip writer that compresses blocks on worker threads.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef GZIP_WRITER_H
+#define GZIP_WRITER_H
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// Writes a gzip stream, compressing independent blocks of the input on worker threads.
+///
+/// Each block is compressed as raw deflate data ending on a byte boundary, primed with the end of
+/// the previous block, so the blocks join into a single valid gzip stream.
+class ParallelGzipWriter {
+public:
+    ParallelGzipWriter(int fd, size_t threadCount, int level = 6, size_t blockSize = 1 << 17);
+    ParallelGzipWriter(const ParallelGzipWriter &other) = delete;
+    ParallelGzipWriter &operator=(const ParallelGzipWriter &other) = delete;
+    ~ParallelGzipWriter();
+    
+    void append(const std::string_view &s);
+    void finish();
+
+private:
+    /// A block of input and its compressed output.
+    struct Block {
+        /// The uncompressed input.
+        std::string input;
+        /// The end of the previous block's input, used as the dictionary.
+        std::string dictionary;
+        /// Whether this is the last block of the stream.
+        bool isLast;
+        /// The compressed output.
+        std::string output;
+        /// The CRC-32 of the input.
+        uint32_t crc;
+        /// Whether the block has been compressed.
+        bool isDone;
+        /// The error message if compressing failed.
+        std::string error;
+    };
+    
+    void submitBlock(bool isLast);
+    void writeNextBlock();
+    void runWorker();
+    void stopWorkers();
+    
+    /// The file descriptor to write to.
+    int fd;
+    /// The zlib compression level.
+    int level;
+    /// The number of input bytes in each block.
+    size_t blockSize;
+    /// The input for the next block.
+    std::string input;
+    /// The last bytes of the previous block's input.
+    std::string previousTail;
+    /// Blocks in stream order that have not been written yet.
+    std::deque<std::shared_ptr<Block>> pendingBlocks;
+    /// Blocks waiting for a worker.
+    std::deque<std::shared_ptr<Block>> queuedBlocks;
+    /// Guards the block queues and their states.
+    std::mutex mutex;
+    /// Signals workers that a block is queued or the writer is stopping.
+    std::condition_variable queuedCondition;
+    /// Signals the writer that a block is done.
+    std::condition_variable doneCondition;
+    /// Whether the workers should exit.
+    bool isStopping = false;
+    /// Whether the trailer has been written.
+    bool isFinished = false;
+    /// The CRC-32 of all input written so far.
+    uint32_t crc;
+    /// The number of input bytes written so far.
+    uint64_t inputLength = 0;
+    /// The worker threads.
+    std::vector<std::thread> workers;
+};
+
+#endif
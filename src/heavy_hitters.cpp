@@ -0,0 +1,300 @@
+/**
+ * @file heavy_hitters.cpp
+ * @author Julia
+ * @brief Implements a SpaceSaving sketch for finding the most frequently bought items.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include "utils.h"
+#include "shopping_list.h"
+#include "parallel.h"
+#include "heavy_hitters.h"
+
+/**
+ * @brief Creates a sketch that monitors up to a number of items.
+ * 
+ * Any item whose true count exceeds totalCount / capacity is guaranteed to be monitored.
+ * 
+ * @param capacity The maximum number of monitored items.
+ */
+HeavyHitters::HeavyHitters(size_t capacity) : capacity(std::max<size_t>(1, capacity)) {
+    heap.reserve(this->capacity);
+    positions.reserve(this->capacity * 2);
+}
+
+/**
+ * @brief Restores the heap order after the count at an index has grown.
+ * 
+ * @param index The index of the counter in the heap.
+ */
+void HeavyHitters::siftDown(size_t index) {
+    size_t size = heap.size();
+    
+    while (true) {
+        size_t left = index * 2 + 1;
+        size_t right = left + 1;
+        size_t smallest = index;
+        
+        if (left < size && heap[left].count < heap[smallest].count) {
+            smallest = left;
+        }
+        
+        if (right < size && heap[right].count < heap[smallest].count) {
+            smallest = right;
+        }
+        
+        if (smallest == index) {
+            break;
+        }
+        
+        std::swap(heap[index], heap[smallest]);
+        positions[heap[index].nameHash] = index;
+        positions[heap[smallest].nameHash] = smallest;
+        index = smallest;
+    }
+}
+
+/**
+ * @brief Adds an occurrence of an item.
+ * 
+ * @param nameHash The hash of the item name.
+ * @param name The name of the item. Only copied when the item starts being monitored.
+ * @param weight The number of occurrences to add.
+ */
+void HeavyHitters::add(uint64_t nameHash, const std::string_view &name, uint64_t weight) {
+    totalCount += weight;
+    
+    auto it = positions.find(nameHash);
+    
+    if (it != positions.end()) {
+        // Already monitored.
+        heap[it->second].count += weight;
+        siftDown(it->second);
+        return;
+    }
+    
+    if (heap.size() < capacity) {
+        // Append the counter and sift it up to keep the min-heap order.
+        size_t index = heap.size();
+        
+        heap.push_back(Counter {
+            .nameHash = nameHash,
+            .name = std::string(name),
+            .count = weight,
+            .error = 0,
+        });
+        positions[nameHash] = index;
+        
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            
+            if (heap[parent].count <= heap[index].count) {
+                break;
+            }
+            
+            std::swap(heap[index], heap[parent]);
+            positions[heap[index].nameHash] = index;
+            positions[heap[parent].nameHash] = parent;
+            index = parent;
+        }
+        
+        return;
+    }
+    
+    // Evict the item with the smallest count and inherit its count as the error.
+    Counter &minCounter = heap[0];
+    uint64_t minCount = minCounter.count;
+    
+    positions.erase(minCounter.nameHash);
+    minCounter.nameHash = nameHash;
+    minCounter.name.assign(name.data(), name.length());
+    minCounter.count = minCount + weight;
+    minCounter.error = minCount;
+    positions[nameHash] = 0;
+    siftDown(0);
+}
+
+/**
+ * @brief Gets the smallest count that an unmonitored item could have.
+ * 
+ * @return The smallest monitored count if the sketch is full, 0 otherwise.
+ */
+uint64_t HeavyHitters::getMinCount() const {
+    if (heap.size() < capacity || heap.empty()) {
+        return 0;
+    }
+    
+    return heap[0].count;
+}
+
+/**
+ * @brief Merges another sketch into this one.
+ * 
+ * Items missing from one of the sketches are assumed to have that sketch's minimum count, which
+ * keeps the merged counts as upper bounds with the error widened accordingly.
+ * 
+ * @param other The sketch to merge, e.g. from another thread.
+ */
+void HeavyHitters::merge(const HeavyHitters &other) {
+    uint64_t minCount = getMinCount();
+    uint64_t otherMinCount = other.getMinCount();
+    std::unordered_map<uint64_t, Counter> combined;
+    
+    combined.reserve(heap.size() + other.heap.size());
+    
+    for (const Counter &counter : heap) {
+        combined[counter.nameHash] = Counter {
+            .nameHash = counter.nameHash,
+            .name = counter.name,
+            .count = counter.count + otherMinCount,
+            .error = counter.error + otherMinCount,
+        };
+    }
+    
+    for (const Counter &counter : other.heap) {
+        auto it = combined.find(counter.nameHash);
+        
+        if (it != combined.end()) {
+            // Replace the assumed minimum with the real count.
+            it->second.count += counter.count - otherMinCount;
+            it->second.error += counter.error - otherMinCount;
+        } else {
+            combined[counter.nameHash] = Counter {
+                .nameHash = counter.nameHash,
+                .name = counter.name,
+                .count = counter.count + minCount,
+                .error = counter.error + minCount,
+            };
+        }
+    }
+    
+    std::vector<Counter> counters;
+    
+    counters.reserve(combined.size());
+    
+    for (auto &entry : combined) {
+        counters.push_back(std::move(entry.second));
+    }
+    
+    // Keep only the largest counters.
+    if (counters.size() > capacity) {
+        std::nth_element(counters.begin(), counters.begin() + capacity, counters.end(), [](const Counter &a, const Counter &b) {
+            return a.count > b.count;
+        });
+        counters.resize(capacity);
+    }
+    
+    std::make_heap(counters.begin(), counters.end(), [](const Counter &a, const Counter &b) {
+        return a.count > b.count;
+    });
+    
+    heap = std::move(counters);
+    positions.clear();
+    
+    for (size_t i = 0; i < heap.size(); ++i) {
+        positions[heap[i].nameHash] = i;
+    }
+    
+    totalCount += other.totalCount;
+}
+
+/**
+ * @brief Gets the most frequent items.
+ * 
+ * @param n The maximum number of items to return.
+ * @return The items sorted by descending estimated count.
+ */
+std::vector<HeavyHitter> HeavyHitters::getTop(size_t n) const {
+    std::vector<HeavyHitter> top;
+    
+    top.reserve(heap.size());
+    
+    for (const Counter &counter : heap) {
+        top.push_back(HeavyHitter {
+            .name = counter.name,
+            .count = counter.count,
+            .error = counter.error,
+        });
+    }
+    
+    std::sort(top.begin(), top.end(), [](const HeavyHitter &a, const HeavyHitter &b) {
+        return a.count > b.count;
+    });
+    
+    if (top.size() > n) {
+        top.resize(n);
+    }
+    
+    return top;
+}
+
+/**
+ * @brief Gets the total weight added to the sketch, including merged sketches.
+ * 
+ * @return The total count.
+ */
+uint64_t HeavyHitters::getTotalCount() const {
+    return totalCount;
+}
+
+/**
+ * @brief Finds the most frequent item names in shopping list text on a number of threads.
+ * 
+ * The text is split into chunks at line breaks. Each thread feeds the name hash of every line it
+ * parses into its own sketch, hashing the name where it lies in the text without copying it, and the sketches are merged once at the end, so no counter is shared
+ * between threads.
+ * 
+ * @param content The shopping list text.
+ * @param capacity The maximum number of items each sketch monitors.
+ * @param threadCount The number of threads.
+ * @param chunkSize The number of bytes of text each thread takes at a time. Chunks are extended
+ * to the end of their last line.
+ * @return The merged sketch.
+ */
+HeavyHitters findHeavyHitters(const std::string_view &content, size_t capacity, size_t threadCount, size_t chunkSize) {
+    std::vector<std::string_view> chunks = splitLineChunks(content, chunkSize);
+    
+    threadCount = std::max<size_t>(1, std::min(threadCount, chunks.size()));
+    
+    std::vector<HeavyHitters> sketches = std::vector<HeavyHitters>(threadCount, HeavyHitters(capacity));
+    
+    forEachChunkOnWorker(chunks.size(), threadCount, [&](size_t chunkIndex, size_t workerIndex) {
+        HeavyHitters &sketch = sketches[workerIndex];
+        std::string_view remaining = chunks[chunkIndex];
+        
+        while (!remaining.empty()) {
+            size_t lineEnd = remaining.find('\n');
+            std::string_view line = remaining.substr(0, lineEnd);
+            
+            remaining = lineEnd == std::string_view::npos ? std::string_view() : remaining.substr(lineEnd + 1);
+            
+            if (line.empty() || startsWith(line, "//")) {
+                continue;
+            }
+            
+            try {
+                ShoppingListItemView itemView = parseShoppingListItemView(line);
+                
+                sketch.add(hashString(itemView.name), itemView.name);
+            } catch (std::runtime_error& e) {
+                // Ignore errors and continue to the next line.
+            }
+        }
+    });
+    
+    for (size_t i = 1; i < sketches.size(); ++i) {
+        sketches[0].merge(sketches[i]);
+    }
+    
+    return std::move(sketches[0]);
+}
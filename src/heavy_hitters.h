@@ -0,0 +1,70 @@
+/**
+ * @file heavy_hitters.h
+ * @author Julia
+ * @brief Declares a SpaceSaving sketch for finding the most frequently bought items.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HEAVY_HITTERS_H
+#define HEAVY_HITTERS_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include "item_table.h"
+
+/// An item reported by the heavy hitters sketch.
+struct HeavyHitter {
+    /// The name of the item.
+    std::string name;
+    /// The estimated count of the item. This never underestimates the true count.
+    uint64_t count;
+    /// The maximum overestimation of the count. The true count is at least count - error.
+    uint64_t error;
+};
+
+/// A SpaceSaving sketch tracking the most frequent items in bounded memory.
+class HeavyHitters {
+public:
+    HeavyHitters(size_t capacity);
+    
+    void add(uint64_t nameHash, const std::string_view &name, uint64_t weight = 1);
+    void merge(const HeavyHitters &other);
+    std::vector<HeavyHitter> getTop(size_t n) const;
+    uint64_t getTotalCount() const;
+
+private:
+    /// A monitored item.
+    struct Counter {
+        /// The hash of the item name.
+        uint64_t nameHash;
+        /// The name of the item.
+        std::string name;
+        /// The estimated count.
+        uint64_t count;
+        /// The maximum overestimation of the count.
+        uint64_t error;
+    };
+    
+    uint64_t getMinCount() const;
+    void siftDown(size_t index);
+    
+    /// The maximum number of monitored items.
+    size_t capacity;
+    /// The total weight added to the sketch.
+    uint64_t totalCount = 0;
+    /// The monitored items as a min-heap on count.
+    std::vector<Counter> heap;
+    /// Maps name hashes to their position in the heap.
+    std::unordered_map<uint64_t, size_t> positions;
+};
+
+HeavyHitters findHeavyHitters(const std::string_view &content, size_t capacity, size_t threadCount, size_t chunkSize = DEFAULT_PARSE_CHUNK_SIZE);
+
+#endif
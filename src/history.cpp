@@ -0,0 +1,294 @@
+/**
+ * @file history.cpp
+ * @author Julia
+ * @brief Implements a store of shopping list snapshots for looking up item history.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/stat.h>
+#include "utils.h"
+#include "binary_io.h"
+#include "bloom_filter.h"
+#include "shopping_list.h"
+#include "buffered_writer.h"
+#include "history.h"
+
+/// Identifies serialized histories.
+uint32_t const LIST_HISTORY_MAGIC = 0x3248494c; // "LIH2"
+/// Identifies serialized histories from before file stamps were stored.
+uint32_t const LIST_HISTORY_V1_MAGIC = 0x3148494c; // "LIH1"
+
+/**
+ * @brief Gets the size and modification time of a file.
+ * 
+ * @param filePath The path to the file.
+ * @return The stamp, or all zeros if the file cannot be read, which matches no indexed file.
+ */
+FileStamp getFileStamp(const std::string &filePath) {
+    struct stat fileStat;
+    
+    if (::stat(filePath.c_str(), &fileStat) != 0) {
+        return FileStamp {
+            .size = 0,
+            .modifiedTimeNs = 0,
+        };
+    }
+    
+    return FileStamp {
+        .size = static_cast<uint64_t>(fileStat.st_size),
+        .modifiedTimeNs = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec,
+    };
+}
+
+/**
+ * @brief Checks whether two file stamps are the same.
+ * 
+ * @param a The first stamp.
+ * @param b The second stamp.
+ * @return True if the size and modification time match, false otherwise.
+ */
+bool isSameFileStamp(const FileStamp &a, const FileStamp &b) {
+    return a.size == b.size && a.modifiedTimeNs == b.modifiedTimeNs;
+}
+
+/**
+ * @brief Builds a Bloom filter over the names of items.
+ * 
+ * @param shoppingListItems The items.
+ * @return The filter.
+ */
+BloomFilter buildNameFilter(const std::vector<ShoppingListItem> &shoppingListItems) {
+    BloomFilter nameFilter = BloomFilter(shoppingListItems.size());
+    
+    for (const ShoppingListItem &shoppingListItem : shoppingListItems) {
+        nameFilter.insert(hashString(shoppingListItem.name));
+    }
+    
+    return nameFilter;
+}
+
+/**
+ * @brief Adds a snapshot to the store by reading it from a file.
+ * 
+ * @param filePath The path to the shopping list file.
+ */
+void ListHistory::addSnapshot(const std::string &filePath) {
+    // The stamp is taken first, so a change made while the file is read makes the snapshot stale.
+    FileStamp fileStamp = getFileStamp(filePath);
+    std::vector<ShoppingListItem> shoppingListItems;
+    
+    try {
+        shoppingListItems = readShoppingListFromFile(filePath);
+    } catch (std::runtime_error& e) {
+        throw std::runtime_error("Failed to read \"" + filePath + "\": " + e.what());
+    }
+    
+    indexSnapshot(filePath, fileStamp, shoppingListItems);
+}
+
+/**
+ * @brief Adds a snapshot to the store from items that have already been parsed.
+ * 
+ * Only the Bloom filter and the file's stamp are kept in memory; the items are read again from the
+ * file when a lookup may match the snapshot. Adding a file again replaces its filter, e.g. after
+ * it was edited.
+ * 
+ * @param filePath The path to the shopping list file.
+ * @param shoppingListItems The items in the file.
+ */
+void ListHistory::addSnapshot(const std::string &filePath, const std::vector<ShoppingListItem> &shoppingListItems) {
+    indexSnapshot(filePath, getFileStamp(filePath), shoppingListItems);
+}
+
+/**
+ * @brief Adds or replaces the snapshot of a file.
+ * 
+ * @param filePath The path to the shopping list file.
+ * @param fileStamp The stamp of the file from before the items were read.
+ * @param shoppingListItems The items in the file.
+ */
+void ListHistory::indexSnapshot(const std::string &filePath, const FileStamp &fileStamp, const std::vector<ShoppingListItem> &shoppingListItems) {
+    BloomFilter nameFilter = buildNameFilter(shoppingListItems);
+    
+    for (ListSnapshot &snapshot : snapshots) {
+        if (snapshot.filePath == filePath) {
+            snapshot.fileStamp = fileStamp;
+            snapshot.nameFilter = std::move(nameFilter);
+            return;
+        }
+    }
+    
+    snapshots.push_back(ListSnapshot {
+        .filePath = filePath,
+        .fileStamp = fileStamp,
+        .nameFilter = std::move(nameFilter),
+    });
+}
+
+/**
+ * @brief Finds every occurrence of an item across the snapshots.
+ * 
+ * Snapshots whose filter rules out the name are skipped without being read. A filter is only
+ * trusted while the file's size and modification time match those it was built from; files that
+ * have changed since are read and indexed again, so edits never hide an item.
+ * 
+ * @param name The name of the item.
+ * @return The occurrences of the item, the number of snapshots read and the number indexed again.
+ */
+ItemHistory ListHistory::findItemHistory(const std::string &name) {
+    uint64_t nameHash = hashString(name);
+    ItemHistory history = ItemHistory {
+        .observations = {},
+        .scannedCount = 0,
+        .refreshedCount = 0,
+    };
+    
+    for (ListSnapshot &snapshot : snapshots) {
+        FileStamp fileStamp = getFileStamp(snapshot.filePath);
+        bool isStale = !isSameFileStamp(snapshot.fileStamp, fileStamp);
+        
+        if (!isStale && !snapshot.nameFilter.mayContain(nameHash)) {
+            // The item is definitely not in this snapshot.
+            continue;
+        }
+        
+        history.scannedCount++;
+        
+        std::vector<ShoppingListItem> shoppingListItems;
+        
+        try {
+            shoppingListItems = readShoppingListFromFile(snapshot.filePath);
+        } catch (std::runtime_error& e) {
+            throw std::runtime_error("Failed to read \"" + snapshot.filePath + "\": " + e.what());
+        }
+        
+        if (isStale) {
+            snapshot.fileStamp = fileStamp;
+            snapshot.nameFilter = buildNameFilter(shoppingListItems);
+            history.refreshedCount++;
+        }
+        
+        for (ShoppingListItem &shoppingListItem : shoppingListItems) {
+            if (shoppingListItem.name == name) {
+                history.observations.push_back(ItemObservation {
+                    .filePath = snapshot.filePath,
+                    .item = std::move(shoppingListItem),
+                });
+            }
+        }
+    }
+    
+    return history;
+}
+
+/**
+ * @brief Gets the number of snapshots in the store.
+ * 
+ * @return The number of snapshots.
+ */
+size_t ListHistory::getSnapshotCount() const {
+    return snapshots.size();
+}
+
+/**
+ * @brief Serializes the store to a binary buffer.
+ * 
+ * @return The buffer.
+ */
+std::string ListHistory::serialize() const {
+    std::string out;
+    
+    appendBinary(out, LIST_HISTORY_MAGIC);
+    appendBinary(out, static_cast<uint32_t>(snapshots.size()));
+    
+    for (const ListSnapshot &snapshot : snapshots) {
+        appendBinary(out, static_cast<uint32_t>(snapshot.filePath.length()));
+        out.append(snapshot.filePath);
+        appendBinary(out, snapshot.fileStamp.size);
+        appendBinary(out, snapshot.fileStamp.modifiedTimeNs);
+        snapshot.nameFilter.serialize(out);
+    }
+    
+    return out;
+}
+
+/**
+ * @brief Reads a store from a binary buffer.
+ * 
+ * Older stores have no file stamps, so each of their snapshots is indexed again by its first
+ * lookup.
+ * 
+ * @param in The buffer.
+ * @return The store.
+ */
+ListHistory ListHistory::deserialize(std::string_view in) {
+    uint32_t magic = readBinary<uint32_t>(in);
+    
+    if (magic != LIST_HISTORY_MAGIC && magic != LIST_HISTORY_V1_MAGIC) {
+        throw std::runtime_error("Not a list history buffer");
+    }
+    
+    ListHistory history;
+    uint32_t snapshotCount = readBinary<uint32_t>(in);
+    
+    for (uint32_t i = 0; i < snapshotCount; ++i) {
+        std::string filePath = std::string(readBinaryBytes(in, readBinary<uint32_t>(in)));
+        FileStamp fileStamp = FileStamp {
+            .size = 0,
+            .modifiedTimeNs = 0,
+        };
+        
+        if (magic == LIST_HISTORY_MAGIC) {
+            fileStamp.size = readBinary<uint64_t>(in);
+            fileStamp.modifiedTimeNs = readBinary<int64_t>(in);
+        }
+        
+        history.snapshots.push_back(ListSnapshot {
+            .filePath = std::move(filePath),
+            .fileStamp = fileStamp,
+            .nameFilter = BloomFilter::deserialize(in),
+        });
+    }
+    
+    return history;
+}
+
+/**
+ * @brief Reads a store from a file.
+ * 
+ * @param filePath The path to the store file.
+ * @return The store, or an empty store if the file does not exist.
+ */
+ListHistory readListHistory(const std::string &filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    
+    if (!file.is_open()) {
+        return ListHistory();
+    }
+    
+    std::stringstream contents;
+    
+    contents << file.rdbuf();
+    
+    return ListHistory::deserialize(contents.str());
+}
+
+/**
+ * @brief Writes a store to a file, replacing it.
+ * 
+ * @param filePath The path to the store file.
+ * @param history The store.
+ */
+void writeListHistory(const std::string &filePath, const ListHistory &history) {
+    replaceFile(filePath, history.serialize());
+}
@@ -0,0 +1,80 @@
+/**
+ * @file history.h
+ * @author Julia
+ * @brief Declares a store of shopping list snapshots for looking up item history.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bloom_filter.h"
+#include "shopping_list.h"
+
+/// The size and modification time of a file, to tell when it has changed.
+struct FileStamp {
+    /// The size in bytes.
+    uint64_t size;
+    /// The modification time in nanoseconds since the epoch.
+    int64_t modifiedTimeNs;
+};
+
+/// A shopping list snapshot stored on disk.
+struct ListSnapshot {
+    /// The path to the shopping list file.
+    std::string filePath;
+    /// The stamp of the file when it was indexed. The filter is stale once the file's stamp differs.
+    FileStamp fileStamp;
+    /// A Bloom filter over the hashes of the item names in the snapshot.
+    BloomFilter nameFilter;
+};
+
+/// An occurrence of an item in a snapshot.
+struct ItemObservation {
+    /// The path to the shopping list file the item was found in.
+    std::string filePath;
+    /// The item.
+    ShoppingListItem item;
+};
+
+/// The occurrences of an item across the snapshots.
+struct ItemHistory {
+    /// The occurrences in the order the snapshots were added.
+    std::vector<ItemObservation> observations;
+    /// The number of snapshots that were read. The others were skipped by their filters.
+    size_t scannedCount;
+    /// The number of snapshots whose files had changed since they were indexed, and were indexed
+    /// again.
+    size_t refreshedCount;
+};
+
+/// A store of shopping list snapshots.
+class ListHistory {
+public:
+    void addSnapshot(const std::string &filePath);
+    void addSnapshot(const std::string &filePath, const std::vector<ShoppingListItem> &shoppingListItems);
+    ItemHistory findItemHistory(const std::string &name);
+    size_t getSnapshotCount() const;
+    std::string serialize() const;
+    static ListHistory deserialize(std::string_view in);
+
+private:
+    void indexSnapshot(const std::string &filePath, const FileStamp &fileStamp, const std::vector<ShoppingListItem> &shoppingListItems);
+    
+    /// The snapshots in the order they were added.
+    std::vector<ListSnapshot> snapshots;
+};
+
+FileStamp getFileStamp(const std::string &filePath);
+ListHistory readListHistory(const std::string &filePath);
+void writeListHistory(const std::string &filePath, const ListHistory &history);
+
+#endif
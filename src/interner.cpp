@@ -0,0 +1,102 @@
+/**
+ * @file interner.cpp
+ * @author Julia
+ * @brief Implements a dictionary that maps item names to small integer ids.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "interner.h"
+
+/**
+ * @brief Copies a dictionary.
+ * 
+ * The lookup table views into the names, so it is rebuilt over the copied names.
+ * 
+ * @param other The dictionary to copy.
+ */
+NameInterner::NameInterner(const NameInterner &other) : names(other.names) {
+    ids.reserve(names.size());
+    
+    for (uint32_t id = 0; id < names.size(); ++id) {
+        ids.emplace(std::string_view(names[id]), id);
+    }
+}
+
+/**
+ * @brief Copies a dictionary.
+ * 
+ * @param other The dictionary to copy.
+ * @return This dictionary.
+ */
+NameInterner &NameInterner::operator=(const NameInterner &other) {
+    if (this != &other) {
+        *this = NameInterner(other);
+    }
+    
+    return *this;
+}
+
+/**
+ * @brief Gets the id for a name, adding it to the dictionary if it is new.
+ * 
+ * @param name The name.
+ * @return The id of the name.
+ */
+uint32_t NameInterner::intern(const std::string_view &name) {
+    auto it = ids.find(name);
+    
+    if (it != ids.end()) {
+        return it->second;
+    }
+    
+    uint32_t id = static_cast<uint32_t>(names.size());
+    
+    names.emplace_back(name);
+    ids.emplace(std::string_view(names.back()), id);
+    
+    return id;
+}
+
+/**
+ * @brief Finds the id for a name without adding it.
+ * 
+ * @param name The name.
+ * @return An optional containing the id if the name has been interned.
+ */
+std::optional<uint32_t> NameInterner::find(const std::string_view &name) const {
+    auto it = ids.find(name);
+    
+    if (it == ids.end()) {
+        return std::nullopt;
+    }
+    
+    return it->second;
+}
+
+/**
+ * @brief Gets the name for an id.
+ * 
+ * @param id The id.
+ * @return The name.
+ */
+const std::string &NameInterner::getName(uint32_t id) const {
+    return names.at(id);
+}
+
+/**
+ * @brief Gets the number of interned names.
+ * 
+ * @return The number of names.
+ */
+size_t NameInterner::size() const {
+    return names.size();
+}
@@ -0,0 +1,43 @@
+/**
+ * @file interner.h
+ * @author Julia
+ * @brief Declares a dictionary that maps item names to small integer ids.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef INTERNER_H
+#define INTERNER_H
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/// Maps item names to dense ids so aggregates can be keyed by an integer.
+class NameInterner {
+public:
+    NameInterner() = default;
+    NameInterner(const NameInterner &other);
+    NameInterner(NameInterner &&other) = default;
+    NameInterner &operator=(const NameInterner &other);
+    NameInterner &operator=(NameInterner &&other) = default;
+    
+    uint32_t intern(const std::string_view &name);
+    std::optional<uint32_t> find(const std::string_view &name) const;
+    const std::string &getName(uint32_t id) const;
+    size_t size() const;
+
+private:
+    /// The names by id. A deque keeps the strings in place as it grows.
+    std::deque<std::string> names;
+    /// Maps names to ids. The keys view into names.
+    std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+#endif
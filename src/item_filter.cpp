@@ -0,0 +1,126 @@
+/**
+ * @file item_filter.cpp
+ * @author Julia
+ * @brief Implements filters on shopping list items.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "unit.h"
+#include "utils.h"
+#include "shopping_list.h"
+#include "item_filter.h"
+
+/**
+ * @brief Gets the bit for a CountType in a mask.
+ * 
+ * @param countType The CountType.
+ * @return The bit.
+ */
+uint8_t getCountTypeBit(CountType countType) {
+    return static_cast<uint8_t>(1 << static_cast<int>(countType));
+}
+
+/**
+ * @brief Checks whether an item matches a filter.
+ * 
+ * @param shoppingListItem The item.
+ * @param filter The filter.
+ * @return Whether the item matches.
+ */
+bool matchesItemFilter(const ShoppingListItem &shoppingListItem, const ItemFilter &filter) {
+    if (filter.perUnitCountTypeMask != 0 && (getCountTypeBit(shoppingListItem.perUnitCountType) & filter.perUnitCountTypeMask) == 0) {
+        return false;
+    }
+    
+    if (filter.minTotalPriceCents.has_value() || filter.maxTotalPriceCents.has_value()) {
+        int64_t totalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
+        
+        if (totalPriceCents < filter.minTotalPriceCents.value_or(totalPriceCents)) {
+            return false;
+        }
+        
+        if (totalPriceCents > filter.maxTotalPriceCents.value_or(totalPriceCents)) {
+            return false;
+        }
+    }
+    
+    if (filter.minUnitPrice.has_value() || filter.maxUnitPrice.has_value()) {
+        double unitPrice = getShoppingListItemUnitPrice(shoppingListItem, Unit::Pound);
+        
+        if (unitPrice < filter.minUnitPrice.value_or(unitPrice)) {
+            return false;
+        }
+        
+        if (unitPrice > filter.maxUnitPrice.value_or(unitPrice)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Parses a price in dollars given as an option value.
+ * 
+ * @param s The price, e.g. "4.99".
+ * @return The price in cents.
+ * @throws std::runtime_error If the price is not a finite, non-negative number.
+ */
+double parseFilterPriceCents(const std::string_view &s) {
+    std::optional<double> dollarsOpt = stringToDouble(s);
+    
+    // strtod also accepts "nan" and "inf", which no price can be compared to.
+    if (!dollarsOpt.has_value() || !std::isfinite(*dollarsOpt) || *dollarsOpt < 0) {
+        throw std::runtime_error("Invalid price \"" + std::string(s) + "\"");
+    }
+    
+    return *dollarsOpt * 100;
+}
+
+/**
+ * @brief Adds a command line option to a filter, if it is a filter option.
+ * 
+ * The options are "--min-total=5.00" and "--max-total=20.00" for the total price,
+ * "--min-unit-price=1.99" and "--max-unit-price=4.99" for the price per pound or per item, and
+ * "--priced-by=lb", which may be given more than once.
+ * 
+ * @param arg The option.
+ * @param filter The filter to add the option to.
+ * @return Whether the option is a filter option.
+ * @throws std::runtime_error If the value of the option is invalid.
+ */
+bool parseItemFilterOption(const std::string_view &arg, ItemFilter &filter) {
+    if (startsWith(arg, "--min-total=")) {
+        filter.minTotalPriceCents = std::llround(parseFilterPriceCents(arg.substr(12)));
+    } else if (startsWith(arg, "--max-total=")) {
+        filter.maxTotalPriceCents = std::llround(parseFilterPriceCents(arg.substr(12)));
+    } else if (startsWith(arg, "--min-unit-price=")) {
+        filter.minUnitPrice = parseFilterPriceCents(arg.substr(17));
+    } else if (startsWith(arg, "--max-unit-price=")) {
+        filter.maxUnitPrice = parseFilterPriceCents(arg.substr(17));
+    } else if (startsWith(arg, "--priced-by=")) {
+        std::string_view countTypeStr = arg.substr(12);
+        std::optional<Unit> unitOpt = convertStringToUnit(countTypeStr);
+        
+        if (countTypeStr == "ea") {
+            filter.perUnitCountTypeMask |= getCountTypeBit(CountType::Quantity);
+        } else if (unitOpt.has_value()) {
+            filter.perUnitCountTypeMask |= getCountTypeBit(convertUnitToCountType(*unitOpt));
+        } else {
+            throw std::runtime_error("Invalid unit \"" + std::string(countTypeStr) + "\"");
+        }
+    } else {
+        return false;
+    }
+    
+    return true;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file item_filter.h
+ * @author Julia
+ * @brief Declares filters on shopping list items.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef ITEM_FILTER_H
+#define ITEM_FILTER_H
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include "unit.h"
+#include "shopping_list.h"
+
+/// A filter on shopping list items. Bounds are inclusive and unset bounds match everything.
+struct ItemFilter {
+    /// The lowest total price in cents.
+    std::optional<int64_t> minTotalPriceCents;
+    /// The highest total price in cents.
+    std::optional<int64_t> maxTotalPriceCents;
+    /// The lowest unit price in cents per pound, or per item for counted items.
+    std::optional<double> minUnitPrice;
+    /// The highest unit price in cents per pound, or per item for counted items.
+    std::optional<double> maxUnitPrice;
+    /// The CountTypes items may be priced by, as bits from getCountTypeBit. 0 matches any.
+    uint8_t perUnitCountTypeMask = 0;
+};
+
+uint8_t getCountTypeBit(CountType countType);
+bool matchesItemFilter(const ShoppingListItem &shoppingListItem, const ItemFilter &filter);
+bool parseItemFilterOption(const std::string_view &arg, ItemFilter &filter);
+
+#endif
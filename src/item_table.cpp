@@ -0,0 +1,349 @@
+/**
+ * @file item_table.cpp
+ * @author Julia
+ * @brief Implements a columnar table of items that many threads can append to at once.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "utils.h"
+#include "parallel.h"
+#include "shopping_list.h"
+#include "item_table.h"
+
+/// The number of rows in a segment.
+size_t const ITEM_TABLE_SEGMENT_ROW_COUNT = 1 << 14;
+/// The largest number of segments in a table.
+size_t const ITEM_TABLE_MAX_SEGMENT_COUNT = 1 << 16;
+size_t const DEFAULT_PARSE_CHUNK_SIZE = 1 << 20;
+
+/// A fixed-size block of rows, stored by column.
+struct ItemTableSegment {
+    /// The names of the items.
+    std::string names[ITEM_TABLE_SEGMENT_ROW_COUNT];
+    /// The prices of the items in cents, per unit.
+    int64_t priceCentsPerUnit[ITEM_TABLE_SEGMENT_ROW_COUNT];
+    /// The counts of the items.
+    double counts[ITEM_TABLE_SEGMENT_ROW_COUNT];
+    /// The types of count for the items.
+    CountType countTypes[ITEM_TABLE_SEGMENT_ROW_COUNT];
+    /// The counts of the per units.
+    int64_t perUnitCounts[ITEM_TABLE_SEGMENT_ROW_COUNT];
+    /// The types of count for the prices per unit.
+    CountType perUnitCountTypes[ITEM_TABLE_SEGMENT_ROW_COUNT];
+    /// The states of the rows. A committed state is stored after the other columns are written.
+    std::atomic<RowState> rowStates[ITEM_TABLE_SEGMENT_ROW_COUNT];
+};
+
+/**
+ * @brief Creates an empty table.
+ */
+ItemTable::ItemTable() : segments(new std::atomic<ItemTableSegment *>[ITEM_TABLE_MAX_SEGMENT_COUNT]) {
+    for (size_t i = 0; i < ITEM_TABLE_MAX_SEGMENT_COUNT; ++i) {
+        segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Frees the segments.
+ */
+ItemTable::~ItemTable() {
+    for (size_t i = 0; i < ITEM_TABLE_MAX_SEGMENT_COUNT; ++i) {
+        delete segments[i].load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Gets a segment, allocating it if no thread has yet.
+ * 
+ * Threads that race to allocate the same segment all allocate one, and the losers free theirs.
+ * 
+ * @param segmentIndex The index of the segment.
+ * @return The segment.
+ */
+ItemTableSegment &ItemTable::getOrCreateSegment(size_t segmentIndex) {
+    ItemTableSegment *segment = segments[segmentIndex].load(std::memory_order_acquire);
+    
+    if (segment != nullptr) {
+        return *segment;
+    }
+    
+    // Value initialization zeroes the row states, which is RowState::Pending.
+    ItemTableSegment *newSegment = new ItemTableSegment();
+    
+    if (segments[segmentIndex].compare_exchange_strong(segment, newSegment, std::memory_order_acq_rel)) {
+        return *newSegment;
+    }
+    
+    delete newSegment;
+    
+    return *segment;
+}
+
+/**
+ * @brief Gets a segment without allocating it.
+ * 
+ * @param segmentIndex The index of the segment.
+ * @return The segment, or a null pointer if it has not been allocated.
+ */
+const ItemTableSegment *ItemTable::getSegment(size_t segmentIndex) const {
+    if (segmentIndex >= ITEM_TABLE_MAX_SEGMENT_COUNT) {
+        return nullptr;
+    }
+    
+    return segments[segmentIndex].load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Reserves a range of rows for the calling thread to write.
+ * 
+ * Every reserved row must later be set or skipped.
+ * 
+ * @param rowCount The number of rows.
+ * @return The index of the first row in the range.
+ */
+size_t ItemTable::reserve(size_t rowCount) {
+    size_t firstRow = reservedCount.fetch_add(rowCount, std::memory_order_relaxed);
+    
+    if (rowCount == 0) {
+        return firstRow;
+    }
+    
+    if (firstRow + rowCount > ITEM_TABLE_SEGMENT_ROW_COUNT * ITEM_TABLE_MAX_SEGMENT_COUNT) {
+        throw std::runtime_error("Item table is full");
+    }
+    
+    size_t lastRow = firstRow + rowCount - 1;
+    
+    for (size_t segmentIndex = firstRow / ITEM_TABLE_SEGMENT_ROW_COUNT; segmentIndex <= lastRow / ITEM_TABLE_SEGMENT_ROW_COUNT; ++segmentIndex) {
+        getOrCreateSegment(segmentIndex);
+    }
+    
+    return firstRow;
+}
+
+/**
+ * @brief Writes an item into a reserved row and commits it.
+ * 
+ * @param row The row. Must have been reserved by the calling thread.
+ * @param shoppingListItem The shopping list item.
+ */
+void ItemTable::setItem(size_t row, ShoppingListItem &&shoppingListItem) {
+    ItemTableSegment &segment = *segments[row / ITEM_TABLE_SEGMENT_ROW_COUNT].load(std::memory_order_acquire);
+    size_t offset = row % ITEM_TABLE_SEGMENT_ROW_COUNT;
+    
+    segment.names[offset] = std::move(shoppingListItem.name);
+    segment.priceCentsPerUnit[offset] = shoppingListItem.priceCentsPerUnit;
+    segment.counts[offset] = shoppingListItem.count;
+    segment.countTypes[offset] = shoppingListItem.countType;
+    segment.perUnitCounts[offset] = shoppingListItem.perUnitCount;
+    segment.perUnitCountTypes[offset] = shoppingListItem.perUnitCountType;
+    
+    // Publishes the columns above to readers that see the committed state.
+    segment.rowStates[offset].store(RowState::Committed, std::memory_order_release);
+    committedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Marks a reserved row as never holding an item.
+ * 
+ * @param row The row. Must have been reserved by the calling thread.
+ */
+void ItemTable::skipRow(size_t row) {
+    ItemTableSegment &segment = *segments[row / ITEM_TABLE_SEGMENT_ROW_COUNT].load(std::memory_order_acquire);
+    
+    segment.rowStates[row % ITEM_TABLE_SEGMENT_ROW_COUNT].store(RowState::Skipped, std::memory_order_release);
+}
+
+/**
+ * @brief Reserves a row, writes an item into it and commits it.
+ * 
+ * @param shoppingListItem The shopping list item.
+ * @return The row.
+ */
+size_t ItemTable::append(ShoppingListItem &&shoppingListItem) {
+    size_t row = reserve(1);
+    
+    setItem(row, std::move(shoppingListItem));
+    
+    return row;
+}
+
+/**
+ * @brief Gets the state of a row.
+ * 
+ * @param row The row.
+ * @return The state. Rows that have not been reserved are pending.
+ */
+RowState ItemTable::getRowState(size_t row) const {
+    const ItemTableSegment *segment = getSegment(row / ITEM_TABLE_SEGMENT_ROW_COUNT);
+    
+    if (segment == nullptr) {
+        return RowState::Pending;
+    }
+    
+    return segment->rowStates[row % ITEM_TABLE_SEGMENT_ROW_COUNT].load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Gets the item in a row.
+ * 
+ * Safe to call while other threads are writing.
+ * 
+ * @param row The row.
+ * @return An optional containing the item, or nothing if the row is not committed.
+ */
+std::optional<ShoppingListItem> ItemTable::getItem(size_t row) const {
+    const ItemTableSegment *segment = getSegment(row / ITEM_TABLE_SEGMENT_ROW_COUNT);
+    size_t offset = row % ITEM_TABLE_SEGMENT_ROW_COUNT;
+    
+    if (segment == nullptr || segment->rowStates[offset].load(std::memory_order_acquire) != RowState::Committed) {
+        return std::nullopt;
+    }
+    
+    return ShoppingListItem {
+        .name = segment->names[offset],
+        .priceCentsPerUnit = segment->priceCentsPerUnit[offset],
+        .count = segment->counts[offset],
+        .countType = segment->countTypes[offset],
+        .perUnitCount = segment->perUnitCounts[offset],
+        .perUnitCountType = segment->perUnitCountTypes[offset],
+    };
+}
+
+/**
+ * @brief Calls a function for every committed row.
+ * 
+ * Safe to call while other threads are writing. Rows committed during the call may or may not be
+ * visited.
+ * 
+ * @param callback Called with the row and its item.
+ */
+void ItemTable::forEachItem(const std::function<void(size_t, const ShoppingListItem &)> &callback) const {
+    size_t rowCount = std::min(getReservedCount(), ITEM_TABLE_SEGMENT_ROW_COUNT * ITEM_TABLE_MAX_SEGMENT_COUNT);
+    
+    for (size_t row = 0; row < rowCount; ++row) {
+        std::optional<ShoppingListItem> shoppingListItemOpt = getItem(row);
+        
+        if (shoppingListItemOpt.has_value()) {
+            callback(row, *shoppingListItemOpt);
+        }
+    }
+}
+
+/**
+ * @brief Gets the number of reserved rows, including rows that are not committed yet.
+ * 
+ * @return The number of rows.
+ */
+size_t ItemTable::getReservedCount() const {
+    return reservedCount.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Gets the number of committed rows.
+ * 
+ * @return The number of rows.
+ */
+size_t ItemTable::getCommittedCount() const {
+    return committedCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Checks whether a line holds an item rather than being blank or a comment.
+ * 
+ * @param line The line.
+ * @return Whether the line should be parsed.
+ */
+bool isItemLine(const std::string_view &line) {
+    return !line.empty() && !startsWith(line, "//");
+}
+
+/**
+ * @brief Parses a chunk of shopping list text into a table on the calling thread.
+ * 
+ * Counts the item lines, reserves that many rows and parses each line straight into its row, so
+ * items are never copied between containers. Lines that fail to parse leave skipped rows.
+ * 
+ * @param chunk The text, made of whole lines.
+ * @param itemTable The table to append to.
+ * @return The number of items parsed.
+ */
+size_t parseChunkIntoItemTable(const std::string_view &chunk, ItemTable &itemTable) {
+    size_t lineCount = 0;
+    
+    for (size_t lineStart = 0; lineStart < chunk.length();) {
+        size_t lineEnd = std::min(chunk.find('\n', lineStart), chunk.length());
+        
+        if (isItemLine(chunk.substr(lineStart, lineEnd - lineStart))) {
+            lineCount++;
+        }
+        
+        lineStart = lineEnd + 1;
+    }
+    
+    size_t row = itemTable.reserve(lineCount);
+    size_t parsedCount = 0;
+    std::string line;
+    
+    for (size_t lineStart = 0; lineStart < chunk.length();) {
+        size_t lineEnd = std::min(chunk.find('\n', lineStart), chunk.length());
+        
+        line.assign(chunk.substr(lineStart, lineEnd - lineStart));
+        lineStart = lineEnd + 1;
+        
+        if (!isItemLine(line)) {
+            continue;
+        }
+        
+        try {
+            itemTable.setItem(row, parseShoppingListItemStr(line));
+            parsedCount++;
+        } catch (std::runtime_error& e) {
+            // Ignore errors and continue to the next line.
+            itemTable.skipRow(row);
+        }
+        
+        row++;
+    }
+    
+    return parsedCount;
+}
+
+/**
+ * @brief Parses shopping list text on a number of threads, writing the items into a table.
+ * 
+ * The text is split into chunks at line breaks, and each thread parses whole chunks with
+ * parseChunkIntoItemTable. Rows are in file order within a chunk, but chunks may be appended in
+ * any order.
+ * 
+ * @param content The shopping list text.
+ * @param itemTable The table to append to.
+ * @param threadCount The number of threads.
+ * @param chunkSize The number of bytes of text each thread takes at a time. Chunks are extended
+ * to the end of their last line.
+ * @return The number of items parsed.
+ */
+size_t parseIntoItemTable(const std::string_view &content, ItemTable &itemTable, size_t threadCount, size_t chunkSize) {
+    std::vector<std::string_view> chunks = splitLineChunks(content, chunkSize);
+    
+    std::atomic<size_t> parsedCount = 0;
+    
+    forEachChunk(chunks.size(), std::max<size_t>(1, threadCount), [&](size_t chunkIndex) {
+        parsedCount.fetch_add(parseChunkIntoItemTable(chunks[chunkIndex], itemTable), std::memory_order_relaxed);
+    });
+    
+    return parsedCount.load();
+}
@@ -0,0 +1,74 @@
+/**
+ * @file item_table.h
+ * @author Julia
+ * @brief Declares a columnar table of items that many threads can append to at once.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef ITEM_TABLE_H
+#define ITEM_TABLE_H
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "shopping_list.h"
+
+struct ItemTableSegment;
+
+/// The number of bytes of text each thread parses at a time by default.
+extern const size_t DEFAULT_PARSE_CHUNK_SIZE;
+
+/// The state of a row in an item table.
+enum class RowState : uint8_t {
+    /// The row is reserved but its item has not been written yet.
+    Pending,
+    /// The item is written and visible to readers.
+    Committed,
+    /// The row will never hold an item, e.g. because its line failed to parse.
+    Skipped
+};
+
+/// A table of items stored by column in fixed-size segments. Writers reserve ranges of rows with
+/// an atomic counter and write into them in place. Segments are never moved once allocated, so
+/// readers can read committed rows without locks while writers keep appending.
+class ItemTable {
+public:
+    ItemTable();
+    ItemTable(const ItemTable &other) = delete;
+    ItemTable &operator=(const ItemTable &other) = delete;
+    ~ItemTable();
+    
+    size_t reserve(size_t rowCount);
+    void setItem(size_t row, ShoppingListItem &&shoppingListItem);
+    void skipRow(size_t row);
+    size_t append(ShoppingListItem &&shoppingListItem);
+    RowState getRowState(size_t row) const;
+    std::optional<ShoppingListItem> getItem(size_t row) const;
+    void forEachItem(const std::function<void(size_t, const ShoppingListItem &)> &callback) const;
+    size_t getReservedCount() const;
+    size_t getCommittedCount() const;
+
+private:
+    ItemTableSegment &getOrCreateSegment(size_t segmentIndex);
+    const ItemTableSegment *getSegment(size_t segmentIndex) const;
+    
+    /// The segments by index. A null pointer means the segment has not been allocated.
+    std::unique_ptr<std::atomic<ItemTableSegment *>[]> segments;
+    /// The number of rows reserved by writers.
+    std::atomic<size_t> reservedCount = 0;
+    /// The number of rows committed by writers.
+    std::atomic<size_t> committedCount = 0;
+};
+
+size_t parseChunkIntoItemTable(const std::string_view &chunk, ItemTable &itemTable);
+size_t parseIntoItemTable(const std::string_view &content, ItemTable &itemTable, size_t threadCount, size_t chunkSize = DEFAULT_PARSE_CHUNK_SIZE);
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * @file lean.cpp
+ * @author Julia
+ * @brief Implements a command line path with minimal startup cost.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <unistd.h>
+#include "unit.h"
+#include "utils.h"
+#include "format.h"
+#include "section.h"
+#include "shopping_list.h"
+#include "report_template.h"
+#include "buffered_writer.h"
+#include "lean.h"
+
+/**
+ * @brief Reads a whole file with read(2).
+ * 
+ * @param filePath The path to the file.
+ * @param contents Set to the contents of the file.
+ * @return Whether the file could be read.
+ */
+bool readWholeFile(const char *filePath, std::string &contents) {
+    int fd = ::open(filePath, O_RDONLY);
+    
+    if (fd < 0) {
+        return false;
+    }
+    
+    char buffer[16384];
+    
+    while (true) {
+        ssize_t bytesRead = ::read(fd, buffer, sizeof(buffer));
+        
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        
+        if (bytesRead <= 0) {
+            ::close(fd);
+            
+            return bytesRead == 0;
+        }
+        
+        contents.append(buffer, static_cast<size_t>(bytesRead));
+    }
+}
+
+/**
+ * @brief Formats a total the way an output stream prints centsToDollars, without a stream.
+ * 
+ * @param label The label, e.g. "Total".
+ * @param cents The total in cents.
+ * @return The line, including the newline.
+ */
+std::string formatTotalLine(const char *label, int64_t cents) {
+    char buffer[64];
+    int length = std::snprintf(buffer, sizeof(buffer), "%s: $%g\n", label, centsToDollars(cents));
+    
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+/**
+ * @brief Prints a shopping list without iostreams or locales.
+ * 
+ * Produces the same output as the default path, with prices grouped the way the en_US locale
+ * does. The file is read with a few read calls and the output is written with a single write call.
+ * 
+ * @param argc The number of arguments after "--lean".
+ * @param argv The arguments after "--lean": the file path, an optional unit, and optionally
+ * "--sections" and "--running".
+ * @return The exit code.
+ */
+int runLeanCli(int argc, char *argv[]) {
+    const char *filePath = nullptr;
+    const char *preferredUnitStr = nullptr;
+    bool useSections = false;
+    bool showRunningTotal = false;
+    
+    for (int i = 0; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--sections") {
+            useSections = true;
+        } else if (std::string_view(argv[i]) == "--running") {
+            showRunningTotal = true;
+        } else if (filePath == nullptr) {
+            filePath = argv[i];
+        } else if (preferredUnitStr == nullptr) {
+            preferredUnitStr = argv[i];
+        }
+    }
+    
+    if (filePath == nullptr) {
+        writeAll(STDERR_FILENO, "No file name provided\n");
+        return 1;
+    }
+    
+    Unit preferredUnit = Unit::Pound;
+    std::string out;
+    std::string errors;
+    
+    if (preferredUnitStr != nullptr) {
+        std::optional<Unit> preferredUnitOpt = convertStringToUnit(preferredUnitStr);
+        
+        if (preferredUnitOpt.has_value()) {
+            preferredUnit = std::move(*preferredUnitOpt);
+        } else {
+            out += "Invalid unit \"" + std::string(preferredUnitStr) + "\"; using pounds\n";
+        }
+    }
+    
+    std::string contents;
+    
+    if (!readWholeFile(filePath, contents)) {
+        writeAll(STDERR_FILENO, "Failed to open file.\n");
+        return 1;
+    }
+    
+    const char *templateStr = showRunningTotal ? RUNNING_TOTAL_REPORT_TEMPLATE : DEFAULT_REPORT_TEMPLATE;
+    ReportTemplate reportTemplate = compileReportTemplate(templateStr, preferredUnit, MoneyFormat::Grouped);
+    
+    // Pad by terminal columns so names with accented or wide characters line up.
+    reportTemplate.layout = ColumnLayout::DisplayWidth;
+    
+    std::string_view remaining = contents;
+    int64_t totalPriceCents = 0;
+    // Items before the first header are not in a named section.
+    bool hasSection = false;
+    int64_t sectionTotalPriceCents = 0;
+    bool hasOutput = false;
+    
+    while (!remaining.empty()) {
+        size_t lineEnd = remaining.find('\n');
+        std::string_view line = remaining.substr(0, lineEnd);
+        
+        remaining = lineEnd == std::string_view::npos ? std::string_view() : remaining.substr(lineEnd + 1);
+        
+        // Skip empty lines.
+        if (line.empty()) {
+            continue;
+        }
+        
+        if (startsWith(line, "//")) {
+            std::optional<std::string> sectionOpt = useSections ? parseSectionHeader(line) : std::nullopt;
+            
+            // Skip comments.
+            if (!sectionOpt.has_value()) {
+                continue;
+            }
+            
+            if (hasSection) {
+                out += formatTotalLine("Subtotal", sectionTotalPriceCents);
+            }
+            
+            if (hasOutput) {
+                // Separate the section from the previous one.
+                out += '\n';
+            }
+            
+            hasSection = true;
+            hasOutput = true;
+            sectionTotalPriceCents = 0;
+            out += *sectionOpt;
+            out += '\n';
+            continue;
+        }
+        
+        std::string lineStr = std::string(line);
+        
+        try {
+            ShoppingListItem shoppingListItem = parseShoppingListItemStr(lineStr);
+            int64_t itemTotalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
+            
+            sectionTotalPriceCents += itemTotalPriceCents;
+            totalPriceCents += itemTotalPriceCents;
+            renderReportRow(reportTemplate, shoppingListItem, out, totalPriceCents);
+            hasOutput = true;
+        } catch (std::runtime_error& e) {
+            errors += "Failed to parse line \"" + lineStr + "\": " + e.what() + "; ignoring\n";
+            // Ignore errors and continue to the next line.
+        }
+    }
+    
+    if (hasSection) {
+        out += formatTotalLine("Subtotal", sectionTotalPriceCents);
+    }
+    
+    out += '\n';
+    out += formatTotalLine("Total", totalPriceCents);
+    
+    try {
+        writeAll(STDERR_FILENO, errors);
+        writeAll(STDOUT_FILENO, out);
+    } catch (std::runtime_error& e) {
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,17 @@
+/**
+ * @file lean.h
+ * @author Julia
+ * @brief Declares a command line path with minimal startup cost.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LEAN_H
+#define LEAN_H
+#pragma once
+
+int runLeanCli(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file format_locale.cpp
+ * @author Julia
+ * @brief Formats the locale columns of the lean program without a locale.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * Linked in place of src/format_locale.cpp so the lean program does not construct a locale. Money
+ * is grouped the way the en_US locale groups it, and numbers are not grouped.
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "../format.h"
+
+/**
+ * @brief Formats a number the way an output stream does by default.
+ * 
+ * @param value The number.
+ * @return The formatted number.
+ */
+std::string formatLocaleNumber(double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+/**
+ * @brief Formats a whole number the way an output stream does by default.
+ * 
+ * @param value The number.
+ * @return The formatted number.
+ */
+std::string formatLocaleNumber(int64_t value) {
+    return std::to_string(value);
+}
+
+/**
+ * @brief Formats an amount of money grouped by thousands, without a currency symbol.
+ * 
+ * @param cents The amount in cents.
+ * @return The formatted amount, e.g. "1,234.56".
+ */
+std::string formatLocaleMoney(int64_t cents) {
+    return formatMoney(cents, MoneyFormat::Grouped);
+}
@@ -0,0 +1,26 @@
+/**
+ * @file main.cpp
+ * @author Julia
+ * @brief Prints a shopping list with minimal startup cost.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * Built as its own program from translation units that do not include <iostream>, so no stream
+ * objects are constructed at startup. See the README for the files it is built from.
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include "../lean.h"
+
+/**
+ * @brief Runs the lean command line with every argument after the program name.
+ * 
+ * @param argc The number of arguments.
+ * @param argv The arguments: the file path, an optional unit, and optionally "--sections" and
+ * "--running".
+ * @return The exit code.
+ */
+int main(int argc, char *argv[]) {
+    return runLeanCli(argc - 1, argv + 1);
+}
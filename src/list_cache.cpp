@@ -0,0 +1,430 @@
+/**
+ * @file list_cache.cpp
+ * @author Julia
+ * @brief Implements a binary cache of a parsed shopping list file that grows as the file is appended to.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "utils.h"
+#include "interner.h"
+#include "binary_io.h"
+#include "archive.h"
+#include "shopping_list.h"
+#include "buffered_writer.h"
+#include "list_cache.h"
+
+/// Identifies list cache files.
+uint32_t const LIST_CACHE_MAGIC = 0x3143434c; // "LCC1"
+/// The version of the list cache layout.
+uint32_t const LIST_CACHE_VERSION = 1;
+/// The number of appended blocks after which the cache file is rewritten as a single block, so
+/// files that grow a line at a time do not collect a block per line.
+uint32_t const MAX_LIST_CACHE_BLOCK_COUNT = 64;
+
+/// The header at the start of a list cache file. It is rewritten in place after each append.
+struct ListCacheHeader {
+    /// Identifies the file as a list cache.
+    uint32_t magic;
+    /// The version of the layout.
+    uint32_t version;
+    /// The number of bytes of the list file the cache covers.
+    uint64_t sourceLength;
+    /// The hash of the bytes of the list file the cache covers.
+    uint64_t prefixHash;
+    /// The number of items in all blocks.
+    uint64_t rowCount;
+    /// The number of names in all blocks.
+    uint32_t nameCount;
+    /// The number of blocks.
+    uint32_t blockCount;
+    /// The length of the header and blocks. Bytes past it are from an append that did not finish.
+    uint64_t fileLength;
+    /// The hash of the blocks, to detect damage.
+    uint64_t blockHash;
+};
+
+/**
+ * @brief Appends the columns of one set of items to another.
+ * 
+ * @param columns The columns to add to.
+ * @param other The columns to add.
+ */
+void appendItemColumns(ItemColumns &columns, const ItemColumns &other) {
+    columns.nameIds.insert(columns.nameIds.end(), other.nameIds.begin(), other.nameIds.end());
+    columns.priceCentsPerUnit.insert(columns.priceCentsPerUnit.end(), other.priceCentsPerUnit.begin(), other.priceCentsPerUnit.end());
+    columns.counts.insert(columns.counts.end(), other.counts.begin(), other.counts.end());
+    columns.countTypes.insert(columns.countTypes.end(), other.countTypes.begin(), other.countTypes.end());
+    columns.perUnitCounts.insert(columns.perUnitCounts.end(), other.perUnitCounts.begin(), other.perUnitCounts.end());
+    columns.perUnitCountTypes.insert(columns.perUnitCountTypes.end(), other.perUnitCountTypes.begin(), other.perUnitCountTypes.end());
+}
+
+/**
+ * @brief Serializes a block of a list cache file.
+ * 
+ * A block holds the names first used by its items, followed by the items by column.
+ * 
+ * @param names The item names.
+ * @param firstNameId The id of the first name not stored in an earlier block.
+ * @param columns The items.
+ * @return The block.
+ */
+std::string serializeListCacheBlock(const NameInterner &names, uint32_t firstNameId, const ItemColumns &columns) {
+    std::string out;
+    
+    appendBinary(out, static_cast<uint32_t>(columns.nameIds.size()));
+    appendBinary(out, static_cast<uint32_t>(names.size() - firstNameId));
+    
+    for (uint32_t id = firstNameId; id < names.size(); ++id) {
+        const std::string &name = names.getName(id);
+        
+        appendBinary(out, static_cast<uint32_t>(name.length()));
+        out.append(name);
+    }
+    
+    appendColumn(out, columns.nameIds);
+    appendColumn(out, columns.priceCentsPerUnit);
+    appendColumn(out, columns.counts);
+    appendColumn(out, columns.countTypes);
+    appendColumn(out, columns.perUnitCounts);
+    appendColumn(out, columns.perUnitCountTypes);
+    
+    return out;
+}
+
+/**
+ * @brief Reads a file into a string.
+ * 
+ * @param filePath The path to the file.
+ * @return The contents, or an empty string if the file does not exist.
+ */
+std::string readListCacheFile(const std::string &filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    
+    if (!file.is_open()) {
+        return "";
+    }
+    
+    std::stringstream contents;
+    
+    contents << file.rdbuf();
+    
+    return contents.str();
+}
+
+/**
+ * @brief Replaces a list cache file with a header and a single block.
+ * 
+ * The file is written to a unique temporary path, synced and renamed over the old one, so another
+ * process rebuilding the same cache never sees a partial file.
+ * 
+ * @param cachePath The path to the cache file.
+ * @param header The header.
+ * @param block The block.
+ */
+void writeListCacheFile(const std::string &cachePath, const ListCacheHeader &header, const std::string &block) {
+    std::string out;
+    
+    out.reserve(sizeof(ListCacheHeader) + block.length());
+    appendBinary(out, header);
+    out += block;
+    
+    replaceFile(cachePath, out);
+}
+
+/**
+ * @brief Appends a block to a list cache file in place and updates its header.
+ * 
+ * The block is written and synced before the header, so if the process stops in between, the old
+ * header still describes a complete file and the partial block is overwritten by the next append.
+ * 
+ * @param cachePath The path to the cache file.
+ * @param header The header describing the file with the block.
+ * @param block The block.
+ */
+void appendListCacheBlock(const std::string &cachePath, const ListCacheHeader &header, const std::string &block) {
+    int fd = ::open(cachePath.c_str(), O_WRONLY);
+    
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open list cache file.");
+    }
+    
+    std::string headerBytes;
+    
+    appendBinary(headerBytes, header);
+    
+    try {
+        pwriteAll(fd, block, header.fileLength - block.length());
+        
+        if (::fdatasync(fd) != 0) {
+            throw std::runtime_error("Failed to sync list cache file.");
+        }
+        
+        pwriteAll(fd, headerBytes, 0);
+    } catch (std::runtime_error& e) {
+        ::close(fd);
+        throw;
+    }
+    
+    ::close(fd);
+}
+
+/**
+ * @brief Loads the items of a list file, using and updating its cache file.
+ * 
+ * The cache is used if the bytes it covers are still the start of the file. Then only lines added
+ * after them are parsed, and their items are appended to the cache file as a new block. Otherwise
+ * the whole file is parsed and the cache file is replaced. A last line without a line break may
+ * still be being written, so its items are returned but not stored.
+ * 
+ * @param filePath The path to the list file.
+ * @param cachePath The path to the cache file.
+ * @return The cache.
+ */
+ListCache ListCache::load(const std::string &filePath, const std::string &cachePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open \"" + filePath + "\"");
+    }
+    
+    std::stringstream fileContents;
+    
+    fileContents << file.rdbuf();
+    
+    std::string content = fileContents.str();
+    std::string cacheContents = readListCacheFile(cachePath);
+    ListCache cache;
+    ListCacheHeader header = {};
+    bool isCacheValid = false;
+    
+    if (!cacheContents.empty()) {
+        try {
+            header = cache.readCache(cacheContents, content);
+            isCacheValid = true;
+        } catch (std::runtime_error& e) {
+            // The cache is damaged or was made from different content, so it is rebuilt.
+            cache = ListCache();
+        }
+    }
+    
+    size_t lastLineBreak = content.rfind('\n');
+    size_t coveredLength = lastLineBreak == std::string::npos ? 0 : lastLineBreak + 1;
+    std::string_view contentView = content;
+    std::string_view tail = contentView.substr(cache.sourceLength, coveredLength - cache.sourceLength);
+    
+    cache.lastUpdate = ListCacheUpdate {
+        .status = isCacheValid ? ListCacheStatus::Current : ListCacheStatus::Rebuilt,
+        .parsedByteCount = tail.length(),
+        .appendedRowCount = 0,
+    };
+    
+    if (!isCacheValid || !tail.empty()) {
+        uint32_t firstNameId = static_cast<uint32_t>(cache.names.size());
+        ItemColumns tailColumns = parseChunkColumns(tail, cache.names);
+        
+        appendItemColumns(cache.columns, tailColumns);
+        cache.cachedRowCount = cache.columns.nameIds.size();
+        cache.sourceLength = coveredLength;
+        cache.lastUpdate.appendedRowCount = tailColumns.nameIds.size();
+        
+        header.magic = LIST_CACHE_MAGIC;
+        header.version = LIST_CACHE_VERSION;
+        header.sourceLength = coveredLength;
+        header.prefixHash = isCacheValid ? hashString(tail, header.prefixHash) : hashString(tail);
+        header.rowCount = cache.cachedRowCount;
+        header.nameCount = static_cast<uint32_t>(cache.names.size());
+        
+        if (isCacheValid && header.blockCount < MAX_LIST_CACHE_BLOCK_COUNT) {
+            std::string block = serializeListCacheBlock(cache.names, firstNameId, tailColumns);
+            
+            cache.lastUpdate.status = ListCacheStatus::Appended;
+            header.blockCount++;
+            header.fileLength += block.length();
+            header.blockHash = hashString(block, header.blockHash);
+            appendListCacheBlock(cachePath, header, block);
+        } else {
+            // Merge the blocks so appends stay cheap to read back.
+            std::string block = serializeListCacheBlock(cache.names, 0, cache.columns);
+            
+            if (isCacheValid) {
+                cache.lastUpdate.status = ListCacheStatus::Appended;
+            }
+            
+            header.blockCount = 1;
+            header.fileLength = sizeof(ListCacheHeader) + block.length();
+            header.blockHash = hashString(block);
+            writeListCacheFile(cachePath, header, block);
+        }
+    }
+    
+    if (coveredLength < content.length()) {
+        appendItemColumns(cache.columns, parseChunkColumns(contentView.substr(coveredLength), cache.names));
+    }
+    
+    return cache;
+}
+
+/**
+ * @brief Reads the blocks of a cache file, checking that they still match the list file.
+ * 
+ * @param in The contents of the cache file.
+ * @param content The contents of the list file.
+ * @return The header of the cache file.
+ */
+ListCacheHeader ListCache::readCache(std::string_view in, const std::string_view &content) {
+    ListCacheHeader header = readBinary<ListCacheHeader>(in);
+    
+    if (header.magic != LIST_CACHE_MAGIC || header.version != LIST_CACHE_VERSION) {
+        throw std::runtime_error("Not a list cache file");
+    }
+    
+    if (header.fileLength < sizeof(ListCacheHeader) || header.fileLength - sizeof(ListCacheHeader) > in.length()) {
+        throw std::runtime_error("Truncated list cache file");
+    }
+    
+    // Only the prefix is hashed, so appending to the list file keeps the cache valid.
+    if (header.sourceLength > content.length() || hashString(content.substr(0, header.sourceLength)) != header.prefixHash) {
+        throw std::runtime_error("List cache does not match the file");
+    }
+    
+    in = in.substr(0, header.fileLength - sizeof(ListCacheHeader));
+    
+    if (hashString(in) != header.blockHash) {
+        throw std::runtime_error("Damaged list cache file");
+    }
+    
+    for (uint32_t i = 0; i < header.blockCount; ++i) {
+        uint32_t rowCount = readBinary<uint32_t>(in);
+        uint32_t nameCount = readBinary<uint32_t>(in);
+        
+        for (uint32_t j = 0; j < nameCount; ++j) {
+            uint32_t nameLength = readBinary<uint32_t>(in);
+            
+            names.intern(readBinaryBytes(in, nameLength));
+        }
+        
+        ItemColumns blockColumns;
+        
+        blockColumns.nameIds = readColumn<uint32_t>(in, rowCount);
+        blockColumns.priceCentsPerUnit = readColumn<int64_t>(in, rowCount);
+        blockColumns.counts = readColumn<double>(in, rowCount);
+        blockColumns.countTypes = readColumn<CountType>(in, rowCount);
+        blockColumns.perUnitCounts = readColumn<int64_t>(in, rowCount);
+        blockColumns.perUnitCountTypes = readColumn<CountType>(in, rowCount);
+        
+        for (uint32_t nameId : blockColumns.nameIds) {
+            if (nameId >= names.size()) {
+                throw std::runtime_error("Invalid name id in list cache");
+            }
+        }
+        
+        appendItemColumns(columns, blockColumns);
+    }
+    
+    if (columns.nameIds.size() != header.rowCount || names.size() != header.nameCount) {
+        throw std::runtime_error("Inconsistent list cache file");
+    }
+    
+    cachedRowCount = columns.nameIds.size();
+    sourceLength = header.sourceLength;
+    
+    return header;
+}
+
+/**
+ * @brief Gets the items as structs.
+ * 
+ * @return The items, in file order.
+ */
+std::vector<ShoppingListItem> ListCache::getItems() const {
+    std::vector<ShoppingListItem> result;
+    
+    result.reserve(columns.nameIds.size());
+    
+    for (size_t row = 0; row < columns.nameIds.size(); ++row) {
+        result.push_back(getColumnsItem(columns, row, names.getName(columns.nameIds[row])));
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Gets the items by column.
+ * 
+ * @return The columns.
+ */
+const ItemColumns &ListCache::getColumns() const {
+    return columns;
+}
+
+/**
+ * @brief Gets the item names the name ids refer to.
+ * 
+ * @return The names.
+ */
+const NameInterner &ListCache::getNames() const {
+    return names;
+}
+
+/**
+ * @brief Gets the number of items.
+ * 
+ * @return The number of items.
+ */
+size_t ListCache::getRowCount() const {
+    return columns.nameIds.size();
+}
+
+/**
+ * @brief Gets the number of bytes of the list file the cache file covers.
+ * 
+ * @return The number of bytes.
+ */
+uint64_t ListCache::getSourceLength() const {
+    return sourceLength;
+}
+
+/**
+ * @brief Gets what the last load did.
+ * 
+ * @return The update.
+ */
+const ListCacheUpdate &ListCache::getLastUpdate() const {
+    return lastUpdate;
+}
+
+/**
+ * @brief Gets the path of the cache file for a list file.
+ * 
+ * The name includes a hash of the canonical path, so lists with the same name in different
+ * directories get their own caches, while different paths to the same list share one.
+ * 
+ * @param directory The directory to keep cache files in.
+ * @param filePath The path to the list file.
+ * @return The path to the cache file, named after the list file.
+ */
+std::string getListCachePath(const std::string &directory, const std::string &filePath) {
+    char *canonicalPath = ::realpath(filePath.c_str(), nullptr);
+    // A list that does not exist yet is hashed by the path as given.
+    uint64_t pathHash = hashString(canonicalPath != nullptr ? canonicalPath : filePath);
+    char hashStr[17];
+    
+    std::free(canonicalPath);
+    std::snprintf(hashStr, sizeof(hashStr), "%016llx", static_cast<unsigned long long>(pathHash));
+    
+    return directory + "/" + filePath.substr(filePath.find_last_of('/') + 1) + "-" + hashStr + ".lcache";
+}
@@ -0,0 +1,76 @@
+/**
+ * @file list_cache.h
+ * @author Julia
+ * @brief Declares a binary cache of a parsed shopping list file that grows as the file is appended to.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LIST_CACHE_H
+#define LIST_CACHE_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "interner.h"
+#include "archive.h"
+#include "shopping_list.h"
+
+struct ListCacheHeader;
+
+/// How a list cache was brought up to date with its file.
+enum class ListCacheStatus {
+    /// The cache already covered every line of the file.
+    Current,
+    /// The file had only been appended to, so just the new lines were parsed.
+    Appended,
+    /// The cache was missing or did not match the file, so the whole file was parsed.
+    Rebuilt
+};
+
+/// What loading a list cache did.
+struct ListCacheUpdate {
+    /// How the cache was brought up to date.
+    ListCacheStatus status;
+    /// The number of bytes of the file that were parsed.
+    size_t parsedByteCount;
+    /// The number of items added to the cache file.
+    size_t appendedRowCount;
+};
+
+/// The parsed items of a shopping list file, stored by column in a binary cache file. The cache
+/// records how many bytes of the file it covers and a hash of them, so when lines are only appended
+/// to the file, just the new lines are parsed and their items are appended to the cache file.
+class ListCache {
+public:
+    static ListCache load(const std::string &filePath, const std::string &cachePath);
+    
+    std::vector<ShoppingListItem> getItems() const;
+    const ItemColumns &getColumns() const;
+    const NameInterner &getNames() const;
+    size_t getRowCount() const;
+    uint64_t getSourceLength() const;
+    const ListCacheUpdate &getLastUpdate() const;
+
+private:
+    ListCacheHeader readCache(std::string_view in, const std::string_view &content);
+    
+    /// The item names.
+    NameInterner names;
+    /// The items, including any from a last line that has no line break yet.
+    ItemColumns columns;
+    /// The number of items stored in the cache file.
+    size_t cachedRowCount = 0;
+    /// The number of bytes of the file the cache file covers. Always ends after a line break.
+    uint64_t sourceLength = 0;
+    /// What the last load did.
+    ListCacheUpdate lastUpdate = {};
+};
+
+std::string getListCachePath(const std::string &directory, const std::string &filePath);
+
+#endif
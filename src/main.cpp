@@ -14,11 +14,36 @@
 #include <optional>
 #include <chrono>
 #include <fstream>
+#include <sstream>
 #include <cmath>
+#include <thread>
+#include <algorithm>
 #include "unit.h"
 #include "utils.h"
 #include "shopping_list.h"
 #include "display.h"
+#include "section.h"
+#include "batch.h"
+#include "partition.h"
+#include "export.h"
+#include "archive.h"
+#include "history.h"
+#include "list_cache.h"
+#include "recipe.h"
+#include "catalog.h"
+#include "pantry.h"
+#include "lean.h"
+#include "query.h"
+#include "item_filter.h"
+#include "heavy_hitters.h"
+#include "quantile_sketch.h"
+#include "anomaly.h"
+#include "editable_list.h"
+#include "parse_cache.h"
+#include "cache_snapshot.h"
+#include "report_template.h"
+#include "benchmark.h"
+#include "scaling.h"
 
 /**
  * @brief Runs a benchmark to test the performance of the parser.
@@ -71,81 +96,957 @@ Unit pickUnit(const std::string &unitStr) {
 }
 
 /**
- * @brief Reads a shopping list from a file.
+ * @brief Reads files into one string, ending each with a line break.
  * 
- * @param filePath The path to the shopping list file.
- * @return The shopping list items.
+ * @param filePaths The paths to the files.
+ * @return The contents of the files.
  */
-std::vector<ShoppingListItem> readShoppingListFromFile(std::string &filePath) {
-    std::ifstream file(filePath);
+std::string readFilesContents(const std::vector<std::string> &filePaths) {
+    std::string contents;
     
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file.");
+    for (const std::string &filePath : filePaths) {
+        std::ifstream file(filePath);
+        
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open \"" + filePath + "\"");
+        }
+        
+        std::stringstream fileContents;
+        
+        fileContents << file.rdbuf();
+        contents += fileContents.str();
+        contents += '\n';
+    }
+    
+    return contents;
+}
+
+int main(int argc, char* argv[]) {
+    // Test the performance of the parser.
+    // runBenchmark();
+    // runStringUtilsBenchmark();
+    // runCatalogBenchmark();
+    
+    if (argc > 1 && std::string_view(argv[1]) == "--lean") {
+        // Lean mode: the same as the default, but without iostreams or locales.
+        return runLeanCli(argc - 2, argv + 2);
+    }
+    
+    if (argc > 1 && std::string_view(argv[1]) == "--startup-benchmark") {
+        // Startup benchmark mode: times this program and the lean program given as the next
+        // argument, "bin/main-lean" by default, on a short list.
+        try {
+            runStartupBenchmark(argv[0], argc > 2 ? argv[2] : "bin/main-lean");
+        } catch (std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        
+        return 0;
     }
     
-    std::vector<ShoppingListItem> shoppingListItems;
+    if (argc > 1 && std::string_view(argv[1]) == "--scaling") {
+        // Scaling mode: measures the parallel paths over generated lists and prints CSV.
+        return runScalingCli(argc - 2, argv + 2);
+    }
     
-    for (std::string line; getline(file, line);) {
-        // Skip empty lines.
-        if (line.empty()) {
-            continue;
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        // Batch mode: every argument is a file, except for the options "--unit=kg",
+        // "--partition=section", "--out=dir", "--format=binary", "--export=report.txt", "--running",
+        // "--template={name:<20}{total:>10}", "--layout=auto",
+        // "--archive=lists.lar", "--cache=dir", "--top=10", "--group=name", "--frequent=10",
+        // "--quantiles=prices.pq", "--anomalies", "--sections", "--snapshot=lines.psc" and
+        // "--threads=4". "--top" also takes the filter options of "--find", such as "--min-total=5.00".
+        std::vector<std::string> filePaths;
+        std::string preferredUnitStr = "lb";
+        std::string partitionByStr = "";
+        std::string outputDirectory = ".";
+        std::string partitionFormatStr = "text";
+        std::string exportPath = "";
+        std::string archivePath = "";
+        std::string cacheDirectory = "";
+        std::string quantilesPath = "";
+        std::string snapshotPath = "";
+        bool showRunningTotal = false;
+        std::string templateStr = "";
+        bool findAnomalies = false;
+        bool useSections = false;
+        std::string layoutStr = "bytes";
+        size_t topCount = 0;
+        size_t frequentCount = 0;
+        std::string groupByStr = "name";
+        ItemFilter filter;
+        bool hasFilter = false;
+        size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            try {
+                if (parseItemFilterOption(arg, filter)) {
+                    hasFilter = true;
+                    continue;
+                }
+            } catch (std::runtime_error& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            
+            if (startsWith(arg, "--unit=")) {
+                preferredUnitStr = arg.substr(7);
+            } else if (startsWith(arg, "--partition=")) {
+                partitionByStr = arg.substr(12);
+            } else if (startsWith(arg, "--export=")) {
+                exportPath = arg.substr(9);
+            } else if (startsWith(arg, "--top=")) {
+                std::optional<int64_t> topCountOpt = stringToIntStrict(arg.substr(6));
+                
+                if (!topCountOpt.has_value() || *topCountOpt < 1) {
+                    std::cerr << "Invalid number of groups \"" << arg.substr(6) << "\"" << std::endl;
+                    return 1;
+                }
+                
+                topCount = static_cast<size_t>(*topCountOpt);
+            } else if (startsWith(arg, "--frequent=")) {
+                std::optional<int64_t> frequentCountOpt = stringToIntStrict(arg.substr(11));
+                
+                if (!frequentCountOpt.has_value() || *frequentCountOpt < 1) {
+                    std::cerr << "Invalid number of items \"" << arg.substr(11) << "\"" << std::endl;
+                    return 1;
+                }
+                
+                frequentCount = static_cast<size_t>(*frequentCountOpt);
+            } else if (startsWith(arg, "--group=")) {
+                groupByStr = arg.substr(8);
+                
+                if (groupByStr != "name" && groupByStr != "unit" && groupByStr != "none") {
+                    std::cerr << "Invalid grouping \"" << groupByStr << "\"" << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--sections") {
+                useSections = true;
+            } else if (arg == "--anomalies") {
+                findAnomalies = true;
+            } else if (arg == "--running") {
+                showRunningTotal = true;
+            } else if (startsWith(arg, "--template=")) {
+                templateStr = arg.substr(11);
+            } else if (startsWith(arg, "--layout=")) {
+                layoutStr = arg.substr(9);
+            } else if (startsWith(arg, "--archive=")) {
+                archivePath = arg.substr(10);
+            } else if (startsWith(arg, "--snapshot=")) {
+                snapshotPath = arg.substr(11);
+            } else if (startsWith(arg, "--quantiles=")) {
+                quantilesPath = arg.substr(12);
+            } else if (startsWith(arg, "--cache=")) {
+                cacheDirectory = arg.substr(8);
+            } else if (startsWith(arg, "--format=")) {
+                partitionFormatStr = arg.substr(9);
+            } else if (startsWith(arg, "--out=")) {
+                outputDirectory = arg.substr(6);
+            } else if (startsWith(arg, "--threads=")) {
+                std::optional<int64_t> threadCountOpt = stringToIntStrict(arg.substr(10));
+                
+                if (!threadCountOpt.has_value() || *threadCountOpt < 1) {
+                    std::cerr << "Invalid thread count \"" << arg.substr(10) << "\"" << std::endl;
+                    return 1;
+                }
+                
+                threadCount = static_cast<size_t>(*threadCountOpt);
+            } else {
+                filePaths.push_back(arg);
+            }
+        }
+        
+        if (filePaths.empty()) {
+            std::cerr << "No file names provided" << std::endl;
+            return 1;
+        }
+        
+        if (hasFilter && topCount == 0) {
+            std::cerr << "Filter options are only supported with \"--top\"" << std::endl;
+            return 1;
+        }
+        
+        // A user-defined template replaces the default layout, including its running column.
+        if (templateStr.empty()) {
+            templateStr = showRunningTotal ? RUNNING_TOTAL_REPORT_TEMPLATE : DEFAULT_REPORT_TEMPLATE;
+        }
+        
+        if (frequentCount > 0) {
+            // Print the items that appear on the most lines, estimated in bounded memory.
+            std::string contents;
+            
+            try {
+                contents = readFilesContents(filePaths);
+            } catch (std::runtime_error& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            
+            // Monitor more items than are printed so the counts near the cutoff stay accurate.
+            HeavyHitters heavyHitters = findHeavyHitters(contents, std::max<size_t>(1024, frequentCount * 8), threadCount);
+            
+            for (const HeavyHitter &heavyHitter : heavyHitters.getTop(frequentCount)) {
+                std::cout << std::left << std::setw(20) << heavyHitter.name << std::setw(10) << heavyHitter.count;
+                std::cout << "+/- " << heavyHitter.error << std::endl;
+            }
+            
+            std::cout << "\nItems: " << heavyHitters.getTotalCount() << std::endl;
+            
+            return 0;
+        }
+        
+        if (!snapshotPath.empty()) {
+            // Parse through a cache started from the snapshot of earlier runs, so lines seen before
+            // are not parsed again, then write the snapshot back with the new lines added.
+            Unit preferredUnit = pickUnit(preferredUnitStr);
+            ParseCache parseCache;
+            int64_t totalPriceCents = 0;
+            
+            if (std::ifstream(snapshotPath).is_open()) {
+                try {
+                    parseCache.attachSnapshot(CacheSnapshot::open(snapshotPath));
+                } catch (std::runtime_error& e) {
+                    std::cerr << "Failed to read snapshot \"" << snapshotPath << "\": " << e.what() << "; starting a new one" << std::endl;
+                }
+            }
+            
+            for (const std::string &filePath : filePaths) {
+                std::ifstream file(filePath);
+                
+                if (!file.is_open()) {
+                    std::cerr << "Failed to open \"" << filePath << "\"" << std::endl;
+                    return 1;
+                }
+                
+                int64_t fileTotalPriceCents = 0;
+                
+                std::cout << "== " << filePath << " ==" << std::endl;
+                
+                for (std::string line; std::getline(file, line);) {
+                    // Skip empty lines and comments.
+                    if (line.empty() || startsWith(line, "//")) {
+                        continue;
+                    }
+                    
+                    try {
+                        ShoppingListItem shoppingListItem = parseCache.parse(line);
+                        
+                        printShoppingListItem(shoppingListItem, preferredUnit);
+                        fileTotalPriceCents += getShoppingListItemTotalPrice(shoppingListItem);
+                    } catch (std::runtime_error& e) {
+                        std::cerr << "Failed to parse line \"" << line << "\": " << e.what() << "; ignoring" << std::endl;
+                        // Ignore errors and continue to the next line.
+                    }
+                }
+                
+                std::cout << "\nTotal: $" << centsToDollars(fileTotalPriceCents) << "\n" << std::endl;
+                totalPriceCents += fileTotalPriceCents;
+            }
+            
+            try {
+                writeCacheSnapshot(snapshotPath, parseCache, NameInterner());
+            } catch (std::runtime_error& e) {
+                std::cerr << "Failed to write snapshot \"" << snapshotPath << "\": " << e.what() << std::endl;
+                return 1;
+            }
+            
+            std::cout << "== All files ==" << std::endl;
+            std::cout << "Total: $" << centsToDollars(totalPriceCents) << std::endl;
+            std::cout << "Lines: " << parseCache.getMissCount() << " parsed, " << parseCache.getHitCount() << " from cache" << std::endl;
+            
+            return 0;
+        }
+        
+        if (findAnomalies) {
+            // Stream the files in order through one detector, so each line is checked against the
+            // prices of the lines before it, and print the lines with unusual unit prices.
+            PriceAnomalyDetector detector(pickUnit(preferredUnitStr));
+            
+            for (const std::string &filePath : filePaths) {
+                try {
+                    for (const PriceAnomaly &anomaly : detector.observeFile(filePath)) {
+                        std::cout << filePath << ":" << anomaly.lineNumber << " " << std::left << std::setw(20) << anomaly.name;
+                        std::cout << "$" << std::setw(10) << centsToDollars(std::llround(anomaly.unitPrice));
+                        std::cout << "expected $" << centsToDollars(std::llround(anomaly.expectedUnitPrice)) << std::endl;
+                    }
+                } catch (std::runtime_error& e) {
+                    std::cerr << e.what() << std::endl;
+                    return 1;
+                }
+            }
+            
+            return 0;
+        }
+        
+        if (!quantilesPath.empty()) {
+            // Add the unit prices of the files to the stored sketches and print each item's median
+            // and 95th percentile unit price.
+            try {
+                Unit preferredUnit = pickUnit(preferredUnitStr);
+                PriceQuantiles priceQuantiles = readPriceQuantiles(quantilesPath, preferredUnit);
+                
+                if (priceQuantiles.getPreferredUnit() != preferredUnit) {
+                    std::cerr << "The prices in \"" << quantilesPath << "\" are per " << convertUnitToString(priceQuantiles.getPreferredUnit()) << std::endl;
+                    return 1;
+                }
+                
+                priceQuantiles.merge(collectPriceQuantiles(readFilesContents(filePaths), preferredUnit, threadCount));
+                writePriceQuantiles(quantilesPath, priceQuantiles);
+                
+                const NameInterner &names = priceQuantiles.getNames();
+                
+                for (uint32_t id = 0; id < names.size(); ++id) {
+                    const std::string &name = names.getName(id);
+                    // Sort the sketch once for both quantiles.
+                    std::optional<KllSortedView> viewOpt = priceQuantiles.getSortedView(name);
+                    double medianCents = viewOpt.has_value() ? viewOpt->getQuantile(0.5).value_or(0) : 0;
+                    double p95Cents = viewOpt.has_value() ? viewOpt->getQuantile(0.95).value_or(0) : 0;
+                    
+                    std::cout << std::left << std::setw(20) << name << "median $" << std::setw(10) << centsToDollars(std::llround(medianCents));
+                    std::cout << "p95 $" << centsToDollars(std::llround(p95Cents)) << std::endl;
+                }
+            } catch (std::runtime_error& e) {
+                std::cerr << "Failed to update price quantiles: " << e.what() << std::endl;
+                return 1;
+            }
+            
+            return 0;
+        }
+        
+        if (topCount > 0) {
+            // Print the groups with the highest totals across all of the files.
+            Query query = Query {
+                .filter = filter,
+                .groupBy = groupByStr == "unit" ? GroupBy::PerUnitCountType : groupByStr == "none" ? GroupBy::None : GroupBy::Name,
+                .topCount = topCount,
+            };
+            std::string contents;
+            
+            try {
+                contents = readFilesContents(filePaths);
+            } catch (std::runtime_error& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            
+            QueryResult result = runQueryOnText(query, contents, threadCount);
+            
+            for (const QueryGroup &group : result.topGroups) {
+                std::cout << std::left << std::setw(20) << group.key << std::setw(10) << group.itemCount;
+                std::cout << "$" << centsToDollars(group.totalPriceCents) << std::endl;
+            }
+            
+            std::cout << "\nTotal: $" << centsToDollars(result.totalPriceCents) << std::endl;
+            
+            return 0;
         }
         
-        if (startsWith(line, "//")) {
-            // Skip comments.
-            continue;
+        if (!archivePath.empty()) {
+            // Add the files to the archive, parsing only the chunks it has not seen. A damaged
+            // archive is never replaced, while files that cannot be read are skipped.
+            ListArchive archive;
+            
+            try {
+                archive = readListArchive(archivePath);
+            } catch (std::runtime_error& e) {
+                std::cerr << "Failed to read archive \"" << archivePath << "\": " << e.what() << std::endl;
+                return 1;
+            }
+            
+            for (const std::string &filePath : filePaths) {
+                try {
+                    ArchiveAddResult result = archive.addFile(filePath);
+                    
+                    std::cout << filePath << ": " << result.novelChunkCount << " of " << result.chunkCount << " chunks new" << std::endl;
+                } catch (std::runtime_error& e) {
+                    std::cerr << "Failed to read file \"" << filePath << "\": " << e.what() << "; skipping" << std::endl;
+                }
+            }
+            
+            try {
+                writeListArchive(archivePath, archive);
+            } catch (std::runtime_error& e) {
+                std::cerr << "Failed to write archive \"" << archivePath << "\": " << e.what() << std::endl;
+                return 1;
+            }
+            
+            std::cout << "Stored " << archive.getStoredByteCount() << " bytes for " << archive.getListCount() << " lists" << std::endl;
+            
+            return 0;
         }
         
+        if (!cacheDirectory.empty() && exportPath.empty()) {
+            // Bring the cache of each file up to date, parsing only lines appended since the last run.
+            int64_t totalPriceCents = 0;
+            
+            for (const std::string &filePath : filePaths) {
+                ListCache cache;
+                
+                try {
+                    cache = ListCache::load(filePath, getListCachePath(cacheDirectory, filePath));
+                } catch (std::runtime_error& e) {
+                    std::cerr << "Failed to read \"" << filePath << "\": " << e.what() << std::endl;
+                    return 1;
+                }
+                
+                const ListCacheUpdate &update = cache.getLastUpdate();
+                const char *statusStr = update.status == ListCacheStatus::Current ? "current" : update.status == ListCacheStatus::Appended ? "appended" : "rebuilt";
+                
+                for (const ShoppingListItem &shoppingListItem : cache.getItems()) {
+                    totalPriceCents += getShoppingListItemTotalPrice(shoppingListItem);
+                }
+                
+                std::cout << filePath << ": " << statusStr << ", " << update.parsedByteCount << " bytes parsed, ";
+                std::cout << update.appendedRowCount << " items added, " << cache.getRowCount() << " items" << std::endl;
+            }
+            
+            std::cout << "Total: $" << centsToDollars(totalPriceCents) << std::endl;
+            
+            return 0;
+        }
+        
+        if (!exportPath.empty()) {
+            // Write the items of every file to a single report, read through the caches if given.
+            std::vector<ShoppingListItem> shoppingListItems;
+            int64_t totalPriceCents = 0;
+            
+            for (const std::string &filePath : filePaths) {
+                std::vector<ShoppingListItem> fileItems;
+                
+                try {
+                    fileItems = cacheDirectory.empty() ? readShoppingListFromFile(filePath) : ListCache::load(filePath, getListCachePath(cacheDirectory, filePath)).getItems();
+                } catch (std::runtime_error& e) {
+                    std::cerr << "Failed to read \"" << filePath << "\": " << e.what() << std::endl;
+                    return 1;
+                }
+                
+                for (ShoppingListItem &shoppingListItem : fileItems) {
+                    totalPriceCents += getShoppingListItemTotalPrice(shoppingListItem);
+                    shoppingListItems.push_back(std::move(shoppingListItem));
+                }
+            }
+            
+            ReportTemplate reportTemplate;
+            
+            try {
+                reportTemplate = compileReportTemplate(templateStr, pickUnit(preferredUnitStr));
+            } catch (std::runtime_error& e) {
+                std::cerr << "Invalid template \"" << templateStr << "\": " << e.what() << std::endl;
+                return 1;
+            }
+            
+            std::optional<ColumnLayout> layoutOpt = convertStringToColumnLayout(layoutStr);
+            
+            if (!layoutOpt.has_value()) {
+                std::cerr << "Invalid layout \"" << layoutStr << "\"; expected bytes, width or auto" << std::endl;
+                return 1;
+            }
+            
+            reportTemplate.layout = *layoutOpt;
+            
+            try {
+                if (endsWith(exportPath, ".gz")) {
+                    exportCompressedReport(exportPath, reportTemplate, shoppingListItems, threadCount);
+                } else {
+                    exportReport(exportPath, reportTemplate, shoppingListItems, threadCount);
+                }
+            } catch (std::runtime_error& e) {
+                std::cerr << "Failed to export \"" << exportPath << "\": " << e.what() << std::endl;
+                return 1;
+            }
+            
+            std::cout << "Total: $" << centsToDollars(totalPriceCents) << std::endl;
+            
+            return 0;
+        }
+        
+        if (partitionByStr.empty()) {
+            ReportTemplate reportTemplate;
+            
+            try {
+                reportTemplate = compileConsoleTemplate(templateStr, pickUnit(preferredUnitStr));
+            } catch (std::runtime_error& e) {
+                std::cerr << "Invalid template \"" << templateStr << "\": " << e.what() << std::endl;
+                return 1;
+            }
+            
+            runBatch(filePaths, PrintOptions {
+                .reportTemplate = std::move(reportTemplate),
+                .useSections = useSections,
+            });
+            
+            return 0;
+        }
+        
+        std::optional<PartitionBy> partitionByOpt = convertStringToPartitionBy(partitionByStr);
+        
+        if (!partitionByOpt.has_value()) {
+            std::cerr << "Invalid partition \"" << partitionByStr << "\"; expected file, section or category" << std::endl;
+            return 1;
+        }
+        
+        std::optional<PartitionFormat> partitionFormatOpt = convertStringToPartitionFormat(partitionFormatStr);
+        
+        if (!partitionFormatOpt.has_value()) {
+            std::cerr << "Invalid format \"" << partitionFormatStr << "\"; expected text or binary" << std::endl;
+            return 1;
+        }
+        
+        // Write each partition to its own file instead of the console.
         try {
-            ShoppingListItem shoppingListItem = parseShoppingListItemStr(line);
-            shoppingListItems.push_back(shoppingListItem);
+            int64_t totalPriceCents = runPartitionedBatch(filePaths, PartitionOptions {
+                .partitionFunction = makePartitionFunction(*partitionByOpt),
+                .outputDirectory = outputDirectory,
+                .threadCount = threadCount,
+                .preferredUnit = pickUnit(preferredUnitStr),
+                .format = *partitionFormatOpt,
+            });
+            
+            std::cout << "Total: $" << centsToDollars(totalPriceCents) << std::endl;
         } catch (std::runtime_error& e) {
-            std::cerr << "Failed to parse line \"" << line << "\": " << e.what() << "; ignoring" << std::endl;
-            // Ignore errors and continue to the next line.
+            std::cerr << "Failed to write partitions: " << e.what() << std::endl;
+            return 1;
         }
+        
+        return 0;
     }
     
-    return shoppingListItems;
-}
-
-int main(int argc, char* argv[]) {
-    // Test the performance of the parser.
-    // runBenchmark();
+    if (argc > 1 && std::string(argv[1]) == "--history") {
+        // History mode: the files are added to the index given by "--index=file", then every
+        // occurrence of each item given by "--item=name" is printed. Only the files whose Bloom
+        // filter may contain the name are read. An optional "--unit=kg" may be given.
+        std::vector<std::string> filePaths;
+        std::vector<std::string> itemNames;
+        std::string indexPath = "";
+        std::string preferredUnitStr = "lb";
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            if (startsWith(arg, "--unit=")) {
+                preferredUnitStr = arg.substr(7);
+            } else if (startsWith(arg, "--index=")) {
+                indexPath = arg.substr(8);
+            } else if (startsWith(arg, "--item=")) {
+                itemNames.push_back(arg.substr(7));
+            } else {
+                filePaths.push_back(arg);
+            }
+        }
+        
+        if (indexPath.empty()) {
+            std::cerr << "No index file provided" << std::endl;
+            return 1;
+        }
+        
+        try {
+            ListHistory history = readListHistory(indexPath);
+            
+            if (!filePaths.empty()) {
+                for (const std::string &filePath : filePaths) {
+                    history.addSnapshot(filePath);
+                }
+                
+                writeListHistory(indexPath, history);
+                std::cout << "Indexed " << history.getSnapshotCount() << " lists" << std::endl;
+            }
+            
+            Unit preferredUnit = pickUnit(preferredUnitStr);
+            size_t refreshedCount = 0;
+            
+            for (const std::string &itemName : itemNames) {
+                ItemHistory itemHistory = history.findItemHistory(itemName);
+                
+                std::cout << "== " << itemName << " ==" << std::endl;
+                
+                for (const ItemObservation &observation : itemHistory.observations) {
+                    std::cout << std::left << std::setw(24) << std::setfill(' ') << observation.filePath;
+                    printShoppingListItem(observation.item, preferredUnit);
+                }
+                
+                std::cout << "Read " << itemHistory.scannedCount << " of " << history.getSnapshotCount() << " lists";
+                
+                if (itemHistory.refreshedCount > 0) {
+                    std::cout << " (" << itemHistory.refreshedCount << " changed since indexing)";
+                }
+                
+                std::cout << std::endl;
+                refreshedCount += itemHistory.refreshedCount;
+            }
+            
+            // Keep the filters rebuilt for changed files, so the next lookup can skip them again.
+            if (refreshedCount > 0) {
+                writeListHistory(indexPath, history);
+            }
+        } catch (std::runtime_error& e) {
+            std::cerr << "Failed to look up history: " << e.what() << std::endl;
+            return 1;
+        }
+        
+        return 0;
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--find") {
+        // Find mode: prints the items of the list given by "--list=name" in the archive given by
+        // "--archive=file" that match the options "--min-total=5.00", "--max-total=20.00",
+        // "--min-unit-price=1.99", "--max-unit-price=4.99" and "--priced-by=lb", which may be given
+        // more than once. Chunks whose statistics rule out the filter are not decoded. An optional
+        // "--unit=kg" may be given.
+        std::string archivePath = "";
+        std::string listName = "";
+        std::string preferredUnitStr = "lb";
+        ItemFilter filter;
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            try {
+                if (parseItemFilterOption(arg, filter)) {
+                    continue;
+                }
+            } catch (std::runtime_error& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            
+            if (startsWith(arg, "--unit=")) {
+                preferredUnitStr = arg.substr(7);
+            } else if (startsWith(arg, "--archive=")) {
+                archivePath = arg.substr(10);
+            } else if (startsWith(arg, "--list=")) {
+                listName = arg.substr(7);
+            } else {
+                std::cerr << "Unknown option \"" << arg << "\"" << std::endl;
+                return 1;
+            }
+        }
+        
+        if (archivePath.empty() || listName.empty()) {
+            std::cerr << "No archive or list name provided" << std::endl;
+            return 1;
+        }
+        
+        try {
+            ListArchive archive = readListArchive(archivePath);
+            ArchiveLookup lookup = archive.findListItems(listName, filter);
+            Unit preferredUnit = pickUnit(preferredUnitStr);
+            int64_t totalPriceCents = 0;
+            
+            for (const ShoppingListItem &shoppingListItem : lookup.items) {
+                printShoppingListItem(shoppingListItem, preferredUnit);
+                totalPriceCents += getShoppingListItemTotalPrice(shoppingListItem);
+            }
+            
+            std::cout << "\nTotal: $" << centsToDollars(totalPriceCents) << std::endl;
+            std::cout << "Read " << lookup.scannedChunkCount << " of " << lookup.chunkCount << " chunks" << std::endl;
+        } catch (std::runtime_error& e) {
+            std::cerr << "Failed to search archive \"" << archivePath << "\": " << e.what() << std::endl;
+            return 1;
+        }
+        
+        return 0;
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--expand") {
+        // Expand mode: the argument is a meal plan whose "@ Recipe x 2" lines are looked up in
+        // the directory given by "--recipes=dir". An optional "--unit=kg" may be given.
+        std::string planPath = "";
+        std::string recipeDirectory = ".";
+        std::string preferredUnitStr = "lb";
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            if (startsWith(arg, "--unit=")) {
+                preferredUnitStr = arg.substr(7);
+            } else if (startsWith(arg, "--recipes=")) {
+                recipeDirectory = arg.substr(10);
+            } else {
+                planPath = arg;
+            }
+        }
+        
+        std::ifstream planFile(planPath);
+        
+        if (!planFile.is_open()) {
+            std::cerr << "Failed to open meal plan \"" << planPath << "\"" << std::endl;
+            return 1;
+        }
+        
+        std::stringstream plan;
+        
+        plan << planFile.rdbuf();
+        
+        RecipeBook recipeBook = RecipeBook(recipeDirectory);
+        Unit preferredUnit = pickUnit(preferredUnitStr);
+        int64_t totalPriceCents = 0;
+        
+        try {
+            for (const ShoppingListItem &shoppingListItem : recipeBook.expand(plan.str())) {
+                printShoppingListItem(shoppingListItem, preferredUnit);
+                totalPriceCents += getShoppingListItemTotalPrice(shoppingListItem);
+            }
+        } catch (std::runtime_error& e) {
+            std::cerr << "Failed to expand meal plan: " << e.what() << std::endl;
+            return 1;
+        }
+        
+        std::cout << "\nTotal: $" << centsToDollars(totalPriceCents) << std::endl;
+        
+        return 0;
+    }
     
-    // Get the file path from the command line arguments.
-    std::string filePath;
+    if (argc > 1 && std::string(argv[1]) == "--need") {
+        // Need mode: prints what is left to buy after taking away the pantry given by
+        // "--pantry=file", which is written like a shopping list. An optional "--unit=kg" may be
+        // given.
+        std::string filePath = "";
+        std::string pantryPath = "";
+        std::string preferredUnitStr = "lb";
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            if (startsWith(arg, "--unit=")) {
+                preferredUnitStr = arg.substr(7);
+            } else if (startsWith(arg, "--pantry=")) {
+                pantryPath = arg.substr(9);
+            } else {
+                filePath = arg;
+            }
+        }
+        
+        try {
+            Unit preferredUnit = pickUnit(preferredUnitStr);
+            PantrySubtraction subtraction = subtractPantry(readShoppingListFromFile(filePath), readShoppingListFromFile(pantryPath));
+            
+            for (const ShoppingListItem &shoppingListItem : subtraction.remainingItems) {
+                printShoppingListItem(shoppingListItem, preferredUnit);
+            }
+            
+            std::cout << "\nCovered by pantry: $" << centsToDollars(subtraction.coveredPriceCents);
+            std::cout << " (" << subtraction.coveredItemCount << " items)" << std::endl;
+            std::cout << "Total: $" << centsToDollars(subtraction.totalPriceCents) << std::endl;
+        } catch (std::runtime_error& e) {
+            std::cerr << "Failed to subtract pantry: " << e.what() << std::endl;
+            return 1;
+        }
+        
+        return 0;
+    }
     
-    if (argc > 1) {
-        filePath = argv[1];
-    } else {
+    if (argc > 1 && std::string(argv[1]) == "--match") {
+        // Match mode: each item in the list is matched against the names in the catalog given by
+        // "--catalog=file", which has one name per line. Misspelled names still match.
+        std::string filePath = "";
+        std::string catalogPath = "";
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            if (startsWith(arg, "--catalog=")) {
+                catalogPath = arg.substr(10);
+            } else {
+                filePath = arg;
+            }
+        }
+        
+        std::ifstream catalogFile(catalogPath);
+        
+        if (!catalogFile.is_open()) {
+            std::cerr << "Failed to open catalog \"" << catalogPath << "\"" << std::endl;
+            return 1;
+        }
+        
+        FuzzyCatalog catalog;
+        std::string line;
+        
+        while (std::getline(catalogFile, line)) {
+            if (!normalizeItemName(line).empty()) {
+                catalog.add(line);
+            }
+        }
+        
+        std::vector<ShoppingListItem> shoppingListItems;
+        
+        try {
+            shoppingListItems = readShoppingListFromFile(filePath);
+        } catch (std::runtime_error& e) {
+            std::cerr << "Failed to read list \"" << filePath << "\": " << e.what() << std::endl;
+            return 1;
+        }
+        
+        for (const ShoppingListItem &shoppingListItem : shoppingListItems) {
+            std::optional<CatalogMatch> matchOpt = catalog.findBestMatch(shoppingListItem.name);
+            
+            if (matchOpt.has_value()) {
+                std::cout << shoppingListItem.name << " -> " << matchOpt->name << " (" << std::setprecision(2) << matchOpt->score << ")" << std::endl;
+            } else {
+                std::cout << shoppingListItem.name << " -> no match" << std::endl;
+            }
+        }
+        
+        return 0;
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--edit") {
+        // Edit mode: loads the list and then reads one command per line from standard input, each
+        // of which edits a single item. Items are numbered from 1 in list order. An optional
+        // "--unit=kg" may be given.
+        std::string filePath = "";
+        std::string preferredUnitStr = "lb";
+        
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            if (startsWith(arg, "--unit=")) {
+                preferredUnitStr = arg.substr(7);
+            } else {
+                filePath = arg;
+            }
+        }
+        
+        std::ifstream file(filePath);
+        
+        if (!file.is_open()) {
+            std::cerr << "Failed to open \"" << filePath << "\"" << std::endl;
+            return 1;
+        }
+        
+        ShoppingList shoppingList(pickUnit(preferredUnitStr));
+        
+        for (std::string line; std::getline(file, line);) {
+            // Skip empty lines and comments.
+            if (line.empty() || startsWith(line, "//")) {
+                continue;
+            }
+            
+            try {
+                shoppingList.insert(line);
+            } catch (std::runtime_error& e) {
+                std::cerr << "Failed to parse line \"" << line << "\": " << e.what() << "; ignoring" << std::endl;
+                // Ignore errors and continue to the next line.
+            }
+        }
+        
+        // The commands are "add <line>", "insert <n> <line>", "set <n> <line>", "delete <n>" and
+        // "print". Only the edited item is parsed and the total is adjusted by its difference.
+        for (std::string command; std::getline(std::cin, command);) {
+            std::istringstream commandStream(command);
+            std::string action;
+            std::string numberStr;
+            std::string line;
+            
+            commandStream >> action;
+            
+            if (action == "print") {
+                std::string out;
+                
+                shoppingList.render(out);
+                std::cout << out;
+            } else if (action == "add") {
+                std::getline(commandStream >> std::ws, line);
+                
+                try {
+                    shoppingList.insert(line);
+                } catch (std::runtime_error& e) {
+                    std::cerr << "Failed to parse line \"" << line << "\": " << e.what() << std::endl;
+                    continue;
+                }
+            } else if (action == "insert" || action == "set" || action == "delete") {
+                commandStream >> numberStr;
+                std::getline(commandStream >> std::ws, line);
+                
+                std::optional<int64_t> numberOpt = stringToIntStrict(numberStr);
+                
+                if (!numberOpt.has_value() || *numberOpt < 1 || static_cast<size_t>(*numberOpt) > shoppingList.size()) {
+                    std::cerr << "Invalid item number \"" << numberStr << "\"" << std::endl;
+                    continue;
+                }
+                
+                ItemHandle handle = shoppingList.getHandles()[*numberOpt - 1];
+                
+                try {
+                    if (action == "insert") {
+                        shoppingList.insertBefore(handle, line);
+                    } else if (action == "set") {
+                        shoppingList.update(handle, line);
+                    } else {
+                        shoppingList.erase(handle);
+                    }
+                } catch (std::runtime_error& e) {
+                    std::cerr << "Failed to parse line \"" << line << "\": " << e.what() << std::endl;
+                    continue;
+                }
+            } else if (!action.empty()) {
+                std::cerr << "Unknown command \"" << action << "\"" << std::endl;
+                continue;
+            } else {
+                continue;
+            }
+            
+            std::cout << "Total: $" << centsToDollars(shoppingList.getTotalPriceCents()) << " (" << shoppingList.size() << " items)" << std::endl;
+        }
+        
+        return 0;
+    }
+    
+    // Get the file path and the preferred unit of measurement from the command line arguments.
+    // Section headers are only recognized when "--sections" is given, "--running" adds a running
+    // total column and "--template=" replaces the layout of the rows.
+    std::vector<std::string> positionalArgs;
+    bool useSections = false;
+    bool showRunningTotal = false;
+    std::string templateStr = "";
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--sections") {
+            useSections = true;
+        } else if (std::string(argv[i]) == "--running") {
+            showRunningTotal = true;
+        } else if (startsWith(argv[i], "--template=")) {
+            templateStr = std::string(argv[i]).substr(11);
+        } else {
+            positionalArgs.push_back(argv[i]);
+        }
+    }
+    
+    if (positionalArgs.empty()) {
         std::cerr << "No file name provided" << std::endl;
         return 1;
     }
     
-    // Get the preferred unit of measurement from the command line arguments.
+    std::string filePath = positionalArgs[0];
     std::string preferredUnitStr = "lb";
     
-    if (argc > 2) {
-        preferredUnitStr = argv[2];
+    if (positionalArgs.size() > 1) {
+        preferredUnitStr = positionalArgs[1];
     }
     
-    Unit preferredUnit = pickUnit(preferredUnitStr);
-    
-    // Read the shopping list from the file.
-    auto shoppingListItems = readShoppingListFromFile(filePath);
+    if (templateStr.empty()) {
+        templateStr = showRunningTotal ? RUNNING_TOTAL_REPORT_TEMPLATE : DEFAULT_REPORT_TEMPLATE;
+    }
     
-    int64_t totalPriceCents = 0;
+    ReportTemplate reportTemplate;
     
-    // Print the shopping list.
-    for (ShoppingListItem shoppingListItem : shoppingListItems) {
-        printShoppingListItem(shoppingListItem, preferredUnit);
-        
-        int64_t itemTotalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
-        
-        // Add to the total price.
-        totalPriceCents += itemTotalPriceCents;
+    try {
+        reportTemplate = compileConsoleTemplate(templateStr, pickUnit(preferredUnitStr));
+    } catch (std::runtime_error& e) {
+        std::cerr << "Invalid template \"" << templateStr << "\": " << e.what() << std::endl;
+        return 1;
     }
     
+    SectionTotals sectionTotals;
+    
+    // Print the shopping list as it is read, with a subtotal after each section.
+    int64_t totalPriceCents = printShoppingListFile(filePath, PrintOptions {
+        .reportTemplate = std::move(reportTemplate),
+        .useSections = useSections,
+    }, sectionTotals);
+    
     std::cout << "\nTotal: $" << centsToDollars(totalPriceCents) << std::endl;
     
     return 0;
@@ -0,0 +1,108 @@
+/**
+ * @file pantry.cpp
+ * @author Julia
+ * @brief Implements subtracting a pantry inventory from a shopping list.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "unit.h"
+#include "shopping_list.h"
+#include "pantry.h"
+
+/// Remaining counts below this are treated as nothing left, to absorb rounding in conversions.
+double const PANTRY_EPSILON = 1e-9;
+
+/// The amount of an item in the pantry.
+struct PantryStock {
+    /// The total weight in pounds of the weighed entries.
+    double pounds = 0;
+    /// The total quantity of the counted entries.
+    double quantity = 0;
+};
+
+/**
+ * @brief Subtracts a pantry from a shopping list.
+ * 
+ * The pantry is hashed by normalized name and each item in the list is looked up once, so this
+ * runs in linear time. Weights are converted between units, so 8 oz in the pantry covers half of
+ * 1 lb on the list. Weighed and counted amounts cannot be compared and are left alone. When the
+ * same item is on the list more than once, the pantry is used up by the first entries.
+ * 
+ * @param shoppingListItems The shopping list items.
+ * @param pantryItems The items in the pantry. Their prices are ignored.
+ * @return The items still needed, in list order, with their totals.
+ */
+PantrySubtraction subtractPantry(const std::vector<ShoppingListItem> &shoppingListItems, const std::vector<ShoppingListItem> &pantryItems) {
+    std::unordered_map<std::string, PantryStock> stocks;
+    
+    stocks.reserve(pantryItems.size());
+    
+    for (const ShoppingListItem &pantryItem : pantryItems) {
+        PantryStock &stock = stocks[normalizeItemName(pantryItem.name)];
+        std::optional<Unit> unitOpt = convertCountTypeToUnit(pantryItem.countType);
+        
+        if (unitOpt.has_value()) {
+            stock.pounds += convertWeight(pantryItem.count, *unitOpt, Unit::Pound);
+        } else {
+            stock.quantity += pantryItem.count;
+        }
+    }
+    
+    PantrySubtraction subtraction = PantrySubtraction {
+        .remainingItems = {},
+        .totalPriceCents = 0,
+        .coveredPriceCents = 0,
+        .coveredItemCount = 0,
+    };
+    
+    for (const ShoppingListItem &shoppingListItem : shoppingListItems) {
+        int64_t totalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
+        auto it = stocks.find(normalizeItemName(shoppingListItem.name));
+        
+        if (it == stocks.end()) {
+            subtraction.remainingItems.push_back(shoppingListItem);
+            subtraction.totalPriceCents += totalPriceCents;
+            continue;
+        }
+        
+        PantryStock &stock = it->second;
+        std::optional<Unit> unitOpt = convertCountTypeToUnit(shoppingListItem.countType);
+        ShoppingListItem remainingItem = shoppingListItem;
+        
+        if (unitOpt.has_value()) {
+            double available = convertWeight(stock.pounds, Unit::Pound, *unitOpt);
+            double used = std::min(available, shoppingListItem.count);
+            
+            remainingItem.count -= used;
+            stock.pounds = std::max(0.0, stock.pounds - convertWeight(used, *unitOpt, Unit::Pound));
+        } else {
+            double used = std::min(stock.quantity, shoppingListItem.count);
+            
+            remainingItem.count -= used;
+            stock.quantity -= used;
+        }
+        
+        if (remainingItem.count <= PANTRY_EPSILON) {
+            subtraction.coveredPriceCents += totalPriceCents;
+            subtraction.coveredItemCount++;
+            continue;
+        }
+        
+        int64_t remainingPriceCents = getShoppingListItemTotalPrice(remainingItem);
+        
+        subtraction.coveredPriceCents += totalPriceCents - remainingPriceCents;
+        subtraction.totalPriceCents += remainingPriceCents;
+        subtraction.remainingItems.push_back(std::move(remainingItem));
+    }
+    
+    return subtraction;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file pantry.h
+ * @author Julia
+ * @brief Declares subtracting a pantry inventory from a shopping list.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef PANTRY_H
+#define PANTRY_H
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "shopping_list.h"
+
+/// What is left to buy after subtracting a pantry from a shopping list.
+struct PantrySubtraction {
+    /// The items still needed, with their counts reduced by what is in the pantry.
+    std::vector<ShoppingListItem> remainingItems;
+    /// The total price of the remaining items in cents.
+    int64_t totalPriceCents;
+    /// The price in cents of what the pantry covered.
+    int64_t coveredPriceCents;
+    /// The number of items the pantry covered completely.
+    size_t coveredItemCount;
+};
+
+PantrySubtraction subtractPantry(const std::vector<ShoppingListItem> &shoppingListItems, const std::vector<ShoppingListItem> &pantryItems);
+
+#endif
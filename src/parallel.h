@@ -0,0 +1,132 @@
+/**
+ * @file parallel.h
+ * @author Julia
+ * @brief Helpers for splitting work across threads.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Finds the end of a chunk of text, extended to the end of its last line.
+ * 
+ * @param content The text.
+ * @param chunkStart The offset of the start of the chunk.
+ * @param chunkSize The number of bytes the chunk should have at least.
+ * @return The offset just past the line break that ends the chunk, or the length of the text.
+ */
+inline size_t findLineChunkEnd(const std::string_view &content, size_t chunkStart, size_t chunkSize) {
+    size_t chunkEnd = std::min(chunkStart + std::max<size_t>(1, chunkSize), content.length());
+    size_t lineEnd = content.find('\n', chunkEnd - 1);
+    
+    return lineEnd == std::string_view::npos ? content.length() : lineEnd + 1;
+}
+
+/**
+ * @brief Splits text into chunks of about a size that end at line breaks.
+ * 
+ * @param content The text.
+ * @param chunkSize The number of bytes each chunk should have at least.
+ * @return Views of the chunks, in order.
+ */
+inline std::vector<std::string_view> splitLineChunks(const std::string_view &content, size_t chunkSize) {
+    std::vector<std::string_view> chunks;
+    size_t chunkStart = 0;
+    
+    while (chunkStart < content.length()) {
+        size_t chunkEnd = findLineChunkEnd(content, chunkStart, chunkSize);
+        
+        chunks.push_back(content.substr(chunkStart, chunkEnd - chunkStart));
+        chunkStart = chunkEnd;
+    }
+    
+    return chunks;
+}
+
+/**
+ * @brief Runs a task for every chunk on a number of threads, telling it which thread it is on.
+ * 
+ * Stops handing out chunks after the first error and rethrows it once all threads have finished.
+ * 
+ * @param chunkCount The number of chunks.
+ * @param threadCount The number of threads.
+ * @param task The task, called with the index of the chunk and the index of the thread, which is
+ * less than threadCount. Tasks on the same thread never run at the same time.
+ */
+template<typename Task>
+inline void forEachChunkOnWorker(size_t chunkCount, size_t threadCount, const Task &task) {
+    std::atomic<size_t> nextChunkIndex = 0;
+    std::mutex errorMutex;
+    std::string error = "";
+    
+    auto worker = [&](size_t workerIndex) {
+        while (true) {
+            size_t chunkIndex = nextChunkIndex.fetch_add(1);
+            
+            if (chunkIndex >= chunkCount) {
+                break;
+            }
+            
+            try {
+                task(chunkIndex, workerIndex);
+            } catch (std::runtime_error& e) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                
+                if (error.empty()) {
+                    error = e.what();
+                }
+                
+                nextChunkIndex = chunkCount;
+            }
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    
+    for (size_t i = 1; i < std::min(threadCount, chunkCount); ++i) {
+        threads.emplace_back(worker, i);
+    }
+    
+    // The calling thread works too.
+    worker(0);
+    
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+}
+
+/**
+ * @brief Runs a task for every chunk on a number of threads.
+ * 
+ * Stops handing out chunks after the first error and rethrows it once all threads have finished.
+ * 
+ * @param chunkCount The number of chunks.
+ * @param threadCount The number of threads.
+ * @param task The task, called with the index of the chunk.
+ */
+template<typename Task>
+inline void forEachChunk(size_t chunkCount, size_t threadCount, const Task &task) {
+    forEachChunkOnWorker(chunkCount, threadCount, [&](size_t chunkIndex, size_t /*workerIndex*/) {
+        task(chunkIndex);
+    });
+}
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file parse_cache.cpp
+ * @author Julia
+ * @brief Implements a cache of parsed shopping list lines.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include "shopping_list.h"
+#include "cache_snapshot.h"
+#include "parse_cache.h"
+
+/**
+ * @brief Parses a line, using the cached item if the line has been seen before.
+ * 
+ * Throws like parseShoppingListItemStr if the line cannot be parsed. Failed lines are not cached.
+ * 
+ * @param line The shopping list line.
+ * @return The shopping list item.
+ */
+ShoppingListItem ParseCache::parse(const std::string &line) {
+    auto it = entries.find(line);
+    
+    if (it != entries.end()) {
+        hitCount++;
+        return it->second;
+    }
+    
+    if (snapshot) {
+        std::optional<ShoppingListItem> itemOpt = snapshot->findParsedLine(line);
+        
+        if (itemOpt.has_value()) {
+            hitCount++;
+            return std::move(*itemOpt);
+        }
+    }
+    
+    missCount++;
+    
+    ShoppingListItem shoppingListItem = parseShoppingListItemStr(line);
+    
+    entries.emplace(line, shoppingListItem);
+    
+    return shoppingListItem;
+}
+
+/**
+ * @brief Attaches a snapshot from a previous run so the cache starts warm.
+ * 
+ * @param snapshot The snapshot.
+ */
+void ParseCache::attachSnapshot(std::shared_ptr<const CacheSnapshot> snapshot) {
+    this->snapshot = std::move(snapshot);
+}
+
+/**
+ * @brief Gets the attached snapshot.
+ * 
+ * @return The snapshot, or null if none is attached.
+ */
+const std::shared_ptr<const CacheSnapshot> &ParseCache::getSnapshot() const {
+    return snapshot;
+}
+
+/**
+ * @brief Gets the lines parsed since the cache was created.
+ * 
+ * @return The parsed items by line.
+ */
+const std::unordered_map<std::string, ShoppingListItem> &ParseCache::getEntries() const {
+    return entries;
+}
+
+/**
+ * @brief Gets the number of lines found in the cache or its snapshot.
+ * 
+ * @return The number of hits.
+ */
+uint64_t ParseCache::getHitCount() const {
+    return hitCount;
+}
+
+/**
+ * @brief Gets the number of lines that had to be parsed.
+ * 
+ * @return The number of misses.
+ */
+uint64_t ParseCache::getMissCount() const {
+    return missCount;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file parse_cache.h
+ * @author Julia
+ * @brief Declares a cache of parsed shopping list lines.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef PARSE_CACHE_H
+#define PARSE_CACHE_H
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "shopping_list.h"
+
+class CacheSnapshot;
+
+/// Remembers parsed lines so repeated lines are only parsed once.
+class ParseCache {
+public:
+    ShoppingListItem parse(const std::string &line);
+    void attachSnapshot(std::shared_ptr<const CacheSnapshot> snapshot);
+    const std::shared_ptr<const CacheSnapshot> &getSnapshot() const;
+    const std::unordered_map<std::string, ShoppingListItem> &getEntries() const;
+    uint64_t getHitCount() const;
+    uint64_t getMissCount() const;
+
+private:
+    /// Lines parsed since the cache was created.
+    std::unordered_map<std::string, ShoppingListItem> entries;
+    /// A snapshot from a previous run that is consulted before parsing.
+    std::shared_ptr<const CacheSnapshot> snapshot;
+    /// The number of lines found in the cache.
+    uint64_t hitCount = 0;
+    /// The number of lines that had to be parsed.
+    uint64_t missCount = 0;
+};
+
+#endif
@@ -0,0 +1,313 @@
+/**
+ * @file parse_controller.cpp
+ * @author Julia
+ * @brief Implements a controller that tunes the chunk size and worker count of a parallel parse.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "item_table.h"
+#include "parallel.h"
+#include "parse_controller.h"
+
+/// The smallest chunk size regardless of line length.
+size_t const MIN_PARSE_CHUNK_SIZE = 16 << 10;
+/// The largest chunk size.
+size_t const MAX_PARSE_CHUNK_SIZE = 4 << 20;
+/// The fewest lines in a chunk, so the cost of handing out a chunk is spread over enough work.
+size_t const MIN_PARSE_CHUNK_LINE_COUNT = 256;
+/// The least input per worker that pays for starting a thread.
+size_t const MIN_PARSE_WORKER_BYTE_COUNT = 256 << 10;
+/// The number of chunks each worker should get at the start, so work can be balanced.
+size_t const PARSE_CHUNKS_PER_WORKER = 8;
+/// The share of time spent waiting for chunks above which chunks are made larger.
+double const MAX_PARSE_STALL_FRACTION = 0.05;
+/// The share of per-worker throughput a new worker may cost before it is taken away again.
+double const MIN_PARSE_SCALING_EFFICIENCY = 0.8;
+
+/**
+ * @brief Estimates the average line length by sampling windows spread across the text.
+ * 
+ * @param content The text.
+ * @return The average number of bytes per line, including the line break.
+ */
+double sampleLineLength(const std::string_view &content) {
+    size_t const sampleCount = 16;
+    size_t const sampleSize = 4096;
+    
+    if (content.length() <= sampleCount * sampleSize) {
+        size_t lineCount = std::count(content.begin(), content.end(), '\n');
+        
+        return static_cast<double>(content.length()) / std::max<size_t>(1, lineCount);
+    }
+    
+    size_t lineCount = 0;
+    size_t stride = (content.length() - sampleSize) / (sampleCount - 1);
+    
+    for (size_t i = 0; i < sampleCount; ++i) {
+        std::string_view sample = content.substr(i * stride, sampleSize);
+        
+        lineCount += std::count(sample.begin(), sample.end(), '\n');
+    }
+    
+    return static_cast<double>(sampleCount * sampleSize) / std::max<size_t>(1, lineCount);
+}
+
+/**
+ * @brief Gets the smallest chunk size for a line length.
+ * 
+ * @param lineLength The average line length.
+ * @return The smallest chunk size in bytes.
+ */
+size_t getMinChunkSize(double lineLength) {
+    size_t minChunkSize = static_cast<size_t>(lineLength * MIN_PARSE_CHUNK_LINE_COUNT);
+    
+    return std::clamp(minChunkSize, MIN_PARSE_CHUNK_SIZE, MAX_PARSE_CHUNK_SIZE);
+}
+
+/**
+ * @brief Picks the starting chunk size and worker count from the size of the input.
+ * 
+ * Each worker gets enough input to pay for starting its thread, so small files use few workers.
+ * Chunks are sized so each worker gets several, for balance, but are kept large enough in lines
+ * that handing one out costs little next to parsing it.
+ * 
+ * @param byteCount The size of the input in bytes.
+ * @param lineLength The average line length.
+ * @param maxWorkerCount The most workers to use.
+ * @return The plan.
+ */
+ParsePlan planParse(size_t byteCount, double lineLength, size_t maxWorkerCount) {
+    size_t workerCount = std::clamp<size_t>(byteCount / MIN_PARSE_WORKER_BYTE_COUNT, 1, std::max<size_t>(1, maxWorkerCount));
+    size_t chunkSize = byteCount / (workerCount * PARSE_CHUNKS_PER_WORKER);
+    
+    return ParsePlan {
+        .chunkSize = std::clamp(chunkSize, getMinChunkSize(lineLength), MAX_PARSE_CHUNK_SIZE),
+        .workerCount = workerCount,
+    };
+}
+
+/**
+ * @brief Creates a controller.
+ * 
+ * @param plan The plan to start from.
+ * @param maxWorkerCount The most workers to use.
+ * @param minChunkSize The smallest chunk size.
+ */
+AdaptiveParseController::AdaptiveParseController(const ParsePlan &plan, size_t maxWorkerCount, size_t minChunkSize) :
+    chunkSize(plan.chunkSize),
+    workerCount(plan.workerCount),
+    workerCeiling(std::max<size_t>(1, maxWorkerCount)),
+    minChunkSize(std::min(minChunkSize, plan.chunkSize)) {}
+
+/**
+ * @brief Records a parsed chunk and adjusts the settings once enough chunks have been seen.
+ * 
+ * @param byteCount The size of the chunk.
+ * @param parseSeconds The time taken to parse the chunk.
+ * @param stallSeconds The time the worker waited to get its next chunk.
+ * @param remainingByteCount The bytes not yet handed out.
+ */
+void AdaptiveParseController::recordChunk(size_t byteCount, double parseSeconds, double stallSeconds, size_t remainingByteCount) {
+    windowByteCount += byteCount;
+    windowParseSeconds += parseSeconds;
+    windowStallSeconds += stallSeconds;
+    windowChunkCount++;
+    
+    // Give every worker a couple of chunks in the window so the measurements are comparable.
+    if (windowChunkCount >= std::max<size_t>(4, workerCount * 2)) {
+        adjust(remainingByteCount);
+    }
+}
+
+/**
+ * @brief Adjusts the settings from the measurements in the current window and starts a new one.
+ * 
+ * Chunks are doubled when workers spend too long waiting for them, and halved near the end so the
+ * last chunks are spread across the workers. A worker is added while there is enough input left
+ * to pay for it, and taken away again if it made every worker slower, e.g. because the cores or
+ * memory bandwidth are shared.
+ * 
+ * @param remainingByteCount The bytes not yet handed out.
+ */
+void AdaptiveParseController::adjust(size_t remainingByteCount) {
+    double workerThroughput = windowParseSeconds > 0 ? windowByteCount / windowParseSeconds : 0;
+    double stallFraction = windowStallSeconds / std::max(1e-12, windowParseSeconds + windowStallSeconds);
+    
+    if (stallFraction > MAX_PARSE_STALL_FRACTION && chunkSize < MAX_PARSE_CHUNK_SIZE) {
+        chunkSize = std::min(chunkSize * 2, MAX_PARSE_CHUNK_SIZE);
+        adjustmentCount++;
+    } else if (remainingByteCount < chunkSize * workerCount * 2 && chunkSize > minChunkSize) {
+        chunkSize = std::max(chunkSize / 2, minChunkSize);
+        adjustmentCount++;
+    }
+    
+    if (throughputBeforeAddingWorker > 0 && workerThroughput < throughputBeforeAddingWorker * MIN_PARSE_SCALING_EFFICIENCY) {
+        workerCount--;
+        workerCeiling = workerCount;
+        throughputBeforeAddingWorker = 0;
+        adjustmentCount++;
+    } else if (workerCount < workerCeiling && remainingByteCount >= MIN_PARSE_WORKER_BYTE_COUNT * (workerCount + 1)) {
+        throughputBeforeAddingWorker = workerThroughput;
+        workerCount++;
+        adjustmentCount++;
+    } else {
+        throughputBeforeAddingWorker = 0;
+    }
+    
+    windowByteCount = 0;
+    windowParseSeconds = 0;
+    windowStallSeconds = 0;
+    windowChunkCount = 0;
+}
+
+/**
+ * @brief Gets the number of bytes a worker should take next.
+ * 
+ * @return The chunk size.
+ */
+size_t AdaptiveParseController::getChunkSize() const {
+    return chunkSize;
+}
+
+/**
+ * @brief Gets the number of workers that should be running.
+ * 
+ * @return The number of workers.
+ */
+size_t AdaptiveParseController::getWorkerCount() const {
+    return workerCount;
+}
+
+/**
+ * @brief Gets the number of times the settings were changed.
+ * 
+ * @return The number of adjustments.
+ */
+size_t AdaptiveParseController::getAdjustmentCount() const {
+    return adjustmentCount;
+}
+
+/**
+ * @brief Parses shopping list text into a table, tuning the chunk size and workers as it runs.
+ * 
+ * The run starts from planParse with at most one worker per core. Workers take chunks from a shared cursor under a lock, report the
+ * time they spent parsing and waiting, and start or retire workers to match the controller. The
+ * calling thread is always a worker, so small inputs never start a thread.
+ * 
+ * @param content The shopping list text.
+ * @param itemTable The table to append to.
+ * @param maxWorkerCount The most workers to use, including the calling thread.
+ * @param stats Filled in with what the run did, if not null.
+ * @return The number of items parsed.
+ */
+size_t parseIntoItemTableAdaptive(const std::string_view &content, ItemTable &itemTable, size_t maxWorkerCount, AdaptiveParseStats *stats) {
+    using Clock = std::chrono::steady_clock;
+    
+    maxWorkerCount = std::max<size_t>(1, maxWorkerCount);
+    
+    // Start with at most one worker per core, but let the controller try more if they help.
+    size_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+    double lineLength = sampleLineLength(content);
+    ParsePlan plan = planParse(content.length(), lineLength, std::min(maxWorkerCount, coreCount));
+    AdaptiveParseController controller = AdaptiveParseController(plan, maxWorkerCount, getMinChunkSize(lineLength));
+    std::mutex mutex;
+    std::vector<std::thread> threads;
+    size_t cursor = 0;
+    size_t runningWorkerCount = 1;
+    size_t peakWorkerCount = 1;
+    size_t chunkCount = 0;
+    std::atomic<size_t> itemCount = 0;
+    double stallSeconds = 0;
+    std::string error = "";
+    std::function<void(bool)> worker;
+    
+    worker = [&](bool canRetire) {
+        size_t chunkByteCount = 0;
+        double parseSeconds = 0;
+        
+        while (true) {
+            Clock::time_point waitStart = Clock::now();
+            std::unique_lock<std::mutex> lock(mutex);
+            double stall = std::chrono::duration<double>(Clock::now() - waitStart).count();
+            
+            stallSeconds += stall;
+            
+            if (chunkByteCount > 0) {
+                controller.recordChunk(chunkByteCount, parseSeconds, stall, content.length() - cursor);
+            }
+            
+            // Stop at the end or on an error, and retire if the controller wants fewer workers.
+            if (cursor >= content.length() || !error.empty() || (canRetire && runningWorkerCount > controller.getWorkerCount())) {
+                runningWorkerCount--;
+                return;
+            }
+            
+            while (runningWorkerCount < controller.getWorkerCount()) {
+                threads.emplace_back(worker, true);
+                runningWorkerCount++;
+                peakWorkerCount = std::max(peakWorkerCount, runningWorkerCount);
+            }
+            
+            size_t chunkEnd = findLineChunkEnd(content, cursor, controller.getChunkSize());
+            std::string_view chunk = content.substr(cursor, chunkEnd - cursor);
+            
+            cursor = chunkEnd;
+            chunkCount++;
+            lock.unlock();
+            
+            Clock::time_point parseStart = Clock::now();
+            
+            try {
+                itemCount.fetch_add(parseChunkIntoItemTable(chunk, itemTable), std::memory_order_relaxed);
+            } catch (std::runtime_error& e) {
+                std::lock_guard<std::mutex> errorLock(mutex);
+                
+                if (error.empty()) {
+                    error = e.what();
+                }
+            }
+            
+            chunkByteCount = chunk.length();
+            parseSeconds = std::chrono::duration<double>(Clock::now() - parseStart).count();
+        }
+    };
+    
+    worker(false);
+    
+    // The calling thread only returns once the input is used up, after which no threads start.
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+    
+    if (stats != nullptr) {
+        *stats = AdaptiveParseStats {
+            .itemCount = itemCount.load(),
+            .chunkCount = chunkCount,
+            .initialPlan = plan,
+            .finalChunkSize = controller.getChunkSize(),
+            .peakWorkerCount = peakWorkerCount,
+            .adjustmentCount = controller.getAdjustmentCount(),
+            .stallSeconds = stallSeconds,
+        };
+    }
+    
+    return itemCount.load();
+}
@@ -0,0 +1,85 @@
+/**
+ * @file parse_controller.h
+ * @author Julia
+ * @brief Declares a controller that tunes the chunk size and worker count of a parallel parse.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef PARSE_CONTROLLER_H
+#define PARSE_CONTROLLER_H
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include "item_table.h"
+
+/// The chunk size and worker count a parse starts with.
+struct ParsePlan {
+    /// The number of bytes a worker takes at a time.
+    size_t chunkSize;
+    /// The number of workers.
+    size_t workerCount;
+};
+
+/// What an adaptive parse did.
+struct AdaptiveParseStats {
+    /// The number of items parsed.
+    size_t itemCount;
+    /// The number of chunks handed out.
+    size_t chunkCount;
+    /// The plan from the cost model.
+    ParsePlan initialPlan;
+    /// The chunk size at the end of the run.
+    size_t finalChunkSize;
+    /// The most workers that ran at once.
+    size_t peakWorkerCount;
+    /// The number of times the controller changed the chunk size or worker count.
+    size_t adjustmentCount;
+    /// The total time workers spent waiting for a chunk, in seconds.
+    double stallSeconds;
+};
+
+/// Adjusts the chunk size and number of workers from measurements taken while a parse runs.
+/// Not thread-safe; the pipeline calls it while holding its lock.
+class AdaptiveParseController {
+public:
+    AdaptiveParseController(const ParsePlan &plan, size_t maxWorkerCount, size_t minChunkSize);
+    
+    void recordChunk(size_t byteCount, double parseSeconds, double stallSeconds, size_t remainingByteCount);
+    size_t getChunkSize() const;
+    size_t getWorkerCount() const;
+    size_t getAdjustmentCount() const;
+
+private:
+    void adjust(size_t remainingByteCount);
+    
+    /// The number of bytes a worker takes at a time.
+    size_t chunkSize;
+    /// The number of workers that should be running.
+    size_t workerCount;
+    /// The most workers to try. Lowered when adding a worker made every worker slower.
+    size_t workerCeiling;
+    /// The smallest chunk size, so per-chunk overhead stays small.
+    size_t minChunkSize;
+    /// The bytes parsed in the current window.
+    size_t windowByteCount = 0;
+    /// The time spent parsing in the current window, summed over workers.
+    double windowParseSeconds = 0;
+    /// The time spent waiting for chunks in the current window, summed over workers.
+    double windowStallSeconds = 0;
+    /// The number of chunks in the current window.
+    size_t windowChunkCount = 0;
+    /// The bytes per second of one worker before the last worker was added, or 0.
+    double throughputBeforeAddingWorker = 0;
+    /// The number of adjustments made.
+    size_t adjustmentCount = 0;
+};
+
+double sampleLineLength(const std::string_view &content);
+ParsePlan planParse(size_t byteCount, double lineLength, size_t maxWorkerCount);
+size_t parseIntoItemTableAdaptive(const std::string_view &content, ItemTable &itemTable, size_t maxWorkerCount, AdaptiveParseStats *stats = nullptr);
+
+#endif
@@ -0,0 +1,358 @@
+/**
+ * @file partition.cpp
+ * @author Julia
+ * @brief Implements batch output split into one file per partition.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "unit.h"
+#include "utils.h"
+#include "section.h"
+#include "shopping_list.h"
+#include "report_template.h"
+#include "binary_io.h"
+#include "buffered_writer.h"
+#include "partition.h"
+
+/// The number of bytes buffered per partition file before writing.
+size_t const PARTITION_WRITE_SIZE = 1 << 20;
+
+/// An open partition file.
+struct PartitionFile {
+    /// The file descriptor.
+    int fd;
+    /// Batches the rows into large writes.
+    std::unique_ptr<BufferedWriter> writer;
+    
+    /**
+     * @brief Takes ownership of an open file.
+     * 
+     * @param fd The file descriptor.
+     */
+    PartitionFile(int fd) : fd(fd), writer(std::make_unique<BufferedWriter>(fd, PARTITION_WRITE_SIZE)) {}
+    
+    /**
+     * @brief Flushes and closes the file.
+     */
+    ~PartitionFile() {
+        writer.reset();
+        ::close(fd);
+    }
+};
+
+/**
+ * @brief Converts a string to a way of partitioning.
+ * 
+ * @param s The string, one of "file", "section" or "category".
+ * @return An optional containing the way of partitioning.
+ */
+std::optional<PartitionBy> convertStringToPartitionBy(const std::string_view &s) {
+    if (s == "file") {
+        return PartitionBy::File;
+    } else if (s == "section") {
+        return PartitionBy::Section;
+    } else if (s == "category") {
+        return PartitionBy::Category;
+    }
+    
+    return std::nullopt;
+}
+
+/**
+ * @brief Makes one of the built-in partition functions.
+ * 
+ * @param partitionBy The way of partitioning.
+ * @return The partition function.
+ */
+PartitionFunction makePartitionFunction(PartitionBy partitionBy) {
+    switch (partitionBy) {
+        case PartitionBy::File:
+            return [](const std::string &filePath, const std::string &, const ShoppingListItem &) {
+                size_t slashPos = findLastOfSet(filePath, "/\\\\");
+                
+                return slashPos == std::string::npos ? filePath : filePath.substr(slashPos + 1);
+            };
+        case PartitionBy::Section:
+            return [](const std::string &, const std::string &section, const ShoppingListItem &) {
+                return section.empty() ? std::string("unsectioned") : section;
+            };
+        case PartitionBy::Category:
+            return [](const std::string &, const std::string &, const ShoppingListItem &shoppingListItem) {
+                bool isWeighed = convertCountTypeToUnit(shoppingListItem.perUnitCountType).has_value();
+                
+                return std::string(isWeighed ? "weighed" : "counted");
+            };
+    }
+    // Removes compiler warning about unreachable code.
+    __builtin_unreachable();
+}
+
+/**
+ * @brief Converts a string to a partition file format.
+ * 
+ * @param s The string, either "text" or "binary".
+ * @return An optional containing the format.
+ */
+std::optional<PartitionFormat> convertStringToPartitionFormat(const std::string_view &s) {
+    if (s == "text") {
+        return PartitionFormat::Text;
+    } else if (s == "binary") {
+        return PartitionFormat::Binary;
+    }
+    
+    return std::nullopt;
+}
+
+/**
+ * @brief Converts a partition name to a safe file name.
+ * 
+ * Different partition names can give the same file name, e.g. "Frozen Food" and "Frozen_Food",
+ * so rows are grouped by file name rather than by partition name.
+ * 
+ * @param partition The partition name.
+ * @param format The format of the file.
+ * @return The file name.
+ */
+std::string getPartitionFileName(const std::string &partition, PartitionFormat format) {
+    std::string fileName;
+    
+    for (char c : partition) {
+        bool isSafe = std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.';
+        
+        fileName += isSafe ? c : '_';
+    }
+    
+    if (fileName.empty() || fileName[0] == '.') {
+        fileName = "_" + fileName;
+    }
+    
+    return fileName + (format == PartitionFormat::Binary ? ".rec" : ".out");
+}
+
+/**
+ * @brief Appends a binary record for an item to a buffer.
+ * 
+ * @param shoppingListItem The shopping list item.
+ * @param out The buffer.
+ */
+void appendPartitionRecord(const ShoppingListItem &shoppingListItem, std::string &out) {
+    appendBinary(out, PartitionRecord {
+        .priceCentsPerUnit = shoppingListItem.priceCentsPerUnit,
+        .count = shoppingListItem.count,
+        .perUnitCount = shoppingListItem.perUnitCount,
+        .nameLength = static_cast<uint32_t>(shoppingListItem.name.length()),
+        .countType = static_cast<uint8_t>(shoppingListItem.countType),
+        .perUnitCountType = static_cast<uint8_t>(shoppingListItem.perUnitCountType),
+        .reserved = {0, 0},
+    });
+    out += shoppingListItem.name;
+}
+
+/**
+ * @brief Parses a file and renders its rows into a buffer per partition file.
+ * 
+ * @param filePath The path to the shopping list file.
+ * @param options The partition options.
+ * @param reportTemplate The compiled row template.
+ * @param buffers The buffers by partition file name.
+ * @return The total price of the file in cents.
+ */
+int64_t renderFilePartitions(
+    const std::string &filePath,
+    const PartitionOptions &options,
+    const ReportTemplate &reportTemplate,
+    std::map<std::string, std::string> &buffers
+) {
+    std::ifstream file(filePath);
+    
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file.");
+    }
+    
+    int64_t totalPriceCents = 0;
+    std::string section = "";
+    
+    for (std::string line; getline(file, line);) {
+        if (line.empty()) {
+            continue;
+        }
+        
+        if (startsWith(line, "//")) {
+            std::optional<std::string> sectionOpt = parseSectionHeader(line);
+            
+            if (sectionOpt.has_value()) {
+                section = std::move(*sectionOpt);
+            }
+            
+            continue;
+        }
+        
+        try {
+            ShoppingListItem shoppingListItem = parseShoppingListItemStr(line);
+            std::string partition = options.partitionFunction(filePath, section, shoppingListItem);
+            std::string &buffer = buffers[getPartitionFileName(partition, options.format)];
+            
+            if (options.format == PartitionFormat::Binary) {
+                appendPartitionRecord(shoppingListItem, buffer);
+            } else {
+                renderReportRow(reportTemplate, shoppingListItem, buffer);
+            }
+            
+            totalPriceCents += getShoppingListItemTotalPrice(shoppingListItem);
+        } catch (std::runtime_error& e) {
+            // Ignore errors and continue to the next line.
+        }
+    }
+    
+    return totalPriceCents;
+}
+
+/**
+ * @brief Processes files on worker threads and writes every row to the file for its partition.
+ * 
+ * Each worker renders a whole input file into its own per-partition buffers and hands them to the
+ * calling thread, which writes the files' buffers in input order, so rows keep their input order
+ * within every partition. Workers never wait for each other's writes; they only wait when they
+ * get too far ahead of the writer, which bounds the memory held by rendered files.
+ * 
+ * @param filePaths The paths to the shopping list files.
+ * @param options The partition options.
+ * @return The total price of all files in cents.
+ */
+int64_t runPartitionedBatch(const std::vector<std::string> &filePaths, const PartitionOptions &options) {
+    ReportTemplate reportTemplate = compileReportTemplate(DEFAULT_REPORT_TEMPLATE, options.preferredUnit, MoneyFormat::Grouped);
+    
+    // Partition files are padded like the console output, by terminal columns.
+    reportTemplate.layout = ColumnLayout::DisplayWidth;
+    
+    size_t threadCount = std::max<size_t>(1, std::min(options.threadCount, filePaths.size()));
+    // The most files rendered ahead of the writer.
+    size_t maxPendingFileCount = threadCount * 2;
+    std::atomic<size_t> nextFileIndex = 0;
+    std::atomic<int64_t> totalPriceCents = 0;
+    // The rendered buffers by file index, taken by the writer in input order.
+    std::vector<std::optional<std::map<std::string, std::string>>> renderedFiles(filePaths.size());
+    std::mutex renderedMutex;
+    std::condition_variable renderedCondition;
+    std::condition_variable writtenCondition;
+    size_t nextWriteIndex = 0;
+    
+    auto worker = [&]() {
+        while (true) {
+            size_t fileIndex = nextFileIndex.fetch_add(1);
+            
+            if (fileIndex >= filePaths.size()) {
+                break;
+            }
+            
+            {
+                std::unique_lock<std::mutex> lock(renderedMutex);
+                
+                writtenCondition.wait(lock, [&]() {
+                    return fileIndex < nextWriteIndex + maxPendingFileCount;
+                });
+            }
+            
+            const std::string &filePath = filePaths[fileIndex];
+            std::map<std::string, std::string> buffers;
+            
+            try {
+                totalPriceCents += renderFilePartitions(filePath, options, reportTemplate, buffers);
+            } catch (std::runtime_error& e) {
+                std::cerr << "Failed to read file \"" + filePath + "\": " + e.what() + "; skipping\n";
+            }
+            
+            std::lock_guard<std::mutex> lock(renderedMutex);
+            
+            renderedFiles[fileIndex] = std::move(buffers);
+            renderedCondition.notify_one();
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    
+    // Partition files by file name, so partitions whose names sanitize to the same file share it.
+    std::map<std::string, std::unique_ptr<PartitionFile>> partitionFiles;
+    std::string writeError = "";
+    
+    for (size_t fileIndex = 0; fileIndex < filePaths.size(); ++fileIndex) {
+        std::map<std::string, std::string> buffers;
+        
+        {
+            std::unique_lock<std::mutex> lock(renderedMutex);
+            
+            renderedCondition.wait(lock, [&]() {
+                return renderedFiles[fileIndex].has_value();
+            });
+            buffers = std::move(*renderedFiles[fileIndex]);
+            renderedFiles[fileIndex].reset();
+            nextWriteIndex++;
+        }
+        
+        writtenCondition.notify_all();
+        
+        // Keep taking the rendered files after an error so the workers can finish.
+        if (!writeError.empty()) {
+            continue;
+        }
+        
+        try {
+            for (const auto &[fileName, buffer] : buffers) {
+                std::unique_ptr<PartitionFile> &partitionFile = partitionFiles[fileName];
+                
+                if (!partitionFile) {
+                    std::string path = options.outputDirectory + "/" + fileName;
+                    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                    
+                    if (fd < 0) {
+                        throw std::runtime_error("Failed to open \"" + path + "\"");
+                    }
+                    
+                    partitionFile = std::make_unique<PartitionFile>(fd);
+                }
+                
+                partitionFile->writer->append(buffer);
+            }
+        } catch (std::runtime_error& e) {
+            writeError = e.what();
+        }
+    }
+    
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    
+    if (!writeError.empty()) {
+        throw std::runtime_error(writeError);
+    }
+    
+    for (auto &[fileName, partitionFile] : partitionFiles) {
+        partitionFile->writer->flush();
+    }
+    
+    return totalPriceCents;
+}
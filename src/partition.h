@@ -0,0 +1,82 @@
+/**
+ * @file partition.h
+ * @author Julia
+ * @brief Declares batch output split into one file per partition.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef PARTITION_H
+#define PARTITION_H
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "unit.h"
+#include "shopping_list.h"
+
+/// Ways to split batch output into files.
+enum class PartitionBy {
+    /// One output file per input file.
+    File,
+    /// One output file per section header.
+    Section,
+    /// One output file for weighed items and one for counted items.
+    Category
+};
+
+/// How rows are written to the partition files.
+enum class PartitionFormat {
+    /// Rendered text rows, as printed to the console.
+    Text,
+    /// A PartitionRecord followed by the name bytes for each item.
+    Binary
+};
+
+/// The fixed-size part of a binary partition record. The name bytes follow it.
+struct PartitionRecord {
+    /// The price of the item in cents, per unit.
+    int64_t priceCentsPerUnit;
+    /// The count of the item.
+    double count;
+    /// The count of the per unit.
+    int64_t perUnitCount;
+    /// The length of the name that follows the record.
+    uint32_t nameLength;
+    /// The type of count for the item.
+    uint8_t countType;
+    /// The type of count for the price per unit.
+    uint8_t perUnitCountType;
+    /// Padding.
+    uint8_t reserved[2];
+};
+
+/// Picks the partition for a row from its file, section and item.
+using PartitionFunction = std::function<std::string(const std::string &filePath, const std::string &section, const ShoppingListItem &shoppingListItem)>;
+
+/// Options for partitioned batch output.
+struct PartitionOptions {
+    /// Picks the partition for each row.
+    PartitionFunction partitionFunction;
+    /// The directory to write the partition files to.
+    std::string outputDirectory;
+    /// The number of worker threads.
+    size_t threadCount;
+    /// The preferred unit of measurement.
+    Unit preferredUnit;
+    /// How rows are written.
+    PartitionFormat format;
+};
+
+std::optional<PartitionBy> convertStringToPartitionBy(const std::string_view &s);
+std::optional<PartitionFormat> convertStringToPartitionFormat(const std::string_view &s);
+PartitionFunction makePartitionFunction(PartitionBy partitionBy);
+int64_t runPartitionedBatch(const std::vector<std::string> &filePaths, const PartitionOptions &options);
+
+#endif
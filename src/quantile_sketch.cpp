@@ -0,0 +1,522 @@
+/**
+ * @file quantile_sketch.cpp
+ * @author Julia
+ * @brief Implements mergeable quantile sketches for unit prices.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "unit.h"
+#include "utils.h"
+#include "interner.h"
+#include "binary_io.h"
+#include "shopping_list.h"
+#include "buffered_writer.h"
+#include "parallel.h"
+#include "quantile_sketch.h"
+
+/// Identifies serialized price quantiles.
+uint32_t const PRICE_QUANTILES_MAGIC = 0x31535150; // "PQS1"
+
+/**
+ * @brief Creates an empty sketch.
+ * 
+ * @param k Controls the accuracy of the sketch. Larger values use more memory.
+ */
+KllSketch::KllSketch(uint32_t k) : k(std::max<uint32_t>(8, k)) {
+    levels.emplace_back();
+}
+
+/**
+ * @brief Gets the capacity of a compactor.
+ * 
+ * Capacities shrink geometrically by 2/3 from the top level down.
+ * 
+ * @param level The level of the compactor.
+ * @return The capacity.
+ */
+uint32_t KllSketch::getLevelCapacity(size_t level) const {
+    size_t depth = levels.size() - 1 - level;
+    double capacity = std::ceil(k * std::pow(2.0 / 3.0, static_cast<double>(depth)));
+    
+    return std::max<uint32_t>(2, static_cast<uint32_t>(capacity));
+}
+
+/**
+ * @brief Compacts every level that is over capacity.
+ * 
+ * Compacting a level sorts it and promotes every other value to the next level, so each promoted
+ * value stands for twice as many values as before.
+ */
+void KllSketch::compress() {
+    for (size_t level = 0; level < levels.size(); ++level) {
+        if (levels[level].size() < getLevelCapacity(level)) {
+            continue;
+        }
+        
+        if (level + 1 == levels.size()) {
+            levels.emplace_back();
+        }
+        
+        std::vector<double> &current = levels[level];
+        
+        std::sort(current.begin(), current.end());
+        
+        // Keep one value behind if the count is odd so no weight is lost.
+        size_t start = current.size() % 2;
+        
+        // Pick the even or odd values using the next bit of a xorshift sequence.
+        coinState ^= coinState << 13;
+        coinState ^= coinState >> 7;
+        coinState ^= coinState << 17;
+        
+        size_t offset = coinState & 1;
+        
+        for (size_t i = start + offset; i < current.size(); i += 2) {
+            levels[level + 1].push_back(current[i]);
+        }
+        
+        current.resize(start);
+    }
+}
+
+/**
+ * @brief Adds a value to the sketch.
+ * 
+ * @param value The value.
+ */
+void KllSketch::add(double value) {
+    if (count == 0) {
+        minValue = value;
+        maxValue = value;
+    } else {
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+    
+    count++;
+    levels[0].push_back(value);
+    
+    if (levels[0].size() >= getLevelCapacity(0)) {
+        compress();
+    }
+}
+
+/**
+ * @brief Merges another sketch into this one.
+ * 
+ * @param other The sketch to merge.
+ */
+void KllSketch::merge(const KllSketch &other) {
+    if (other.count == 0) {
+        return;
+    }
+    
+    if (count == 0) {
+        minValue = other.minValue;
+        maxValue = other.maxValue;
+    } else {
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+    
+    while (levels.size() < other.levels.size()) {
+        levels.emplace_back();
+    }
+    
+    for (size_t level = 0; level < other.levels.size(); ++level) {
+        levels[level].insert(levels[level].end(), other.levels[level].begin(), other.levels[level].end());
+    }
+    
+    count += other.count;
+    compress();
+}
+
+/**
+ * @brief Sorts the values of every compactor into one weighted view.
+ * 
+ * Build the view once when asking for several quantiles, since each query on it is a binary
+ * search.
+ * 
+ * @return The view.
+ */
+KllSortedView KllSketch::getSortedView() const {
+    // Each value is weighted by the number of values it stands for.
+    std::vector<std::pair<double, uint64_t>> weighted;
+    KllSortedView view;
+    uint64_t cumulativeWeight = 0;
+    
+    for (size_t level = 0; level < levels.size(); ++level) {
+        uint64_t weight = 1ULL << level;
+        
+        for (double value : levels[level]) {
+            weighted.emplace_back(value, weight);
+        }
+    }
+    
+    std::sort(weighted.begin(), weighted.end());
+    
+    view.values.reserve(weighted.size());
+    view.cumulativeWeights.reserve(weighted.size());
+    view.minValue = minValue;
+    view.maxValue = maxValue;
+    
+    for (const auto &[value, weight] : weighted) {
+        cumulativeWeight += weight;
+        view.values.push_back(value);
+        view.cumulativeWeights.push_back(cumulativeWeight);
+    }
+    
+    return view;
+}
+
+/**
+ * @brief Estimates a quantile.
+ * 
+ * @param q The quantile between 0 and 1, e.g. 0.5 for the median.
+ * @return An optional containing the estimated value, or nothing if the sketch is empty.
+ */
+std::optional<double> KllSketch::getQuantile(double q) const {
+    if (count == 0) {
+        return std::nullopt;
+    }
+    
+    return getSortedView().getQuantile(q);
+}
+
+/**
+ * @brief Estimates a quantile from the sorted values.
+ * 
+ * @param q The quantile between 0 and 1, e.g. 0.5 for the median.
+ * @return An optional containing the estimated value, or nothing if the sketch was empty.
+ */
+std::optional<double> KllSortedView::getQuantile(double q) const {
+    if (values.empty()) {
+        return std::nullopt;
+    }
+    
+    if (q <= 0) {
+        return minValue;
+    }
+    
+    if (q >= 1) {
+        return maxValue;
+    }
+    
+    double targetWeight = q * static_cast<double>(cumulativeWeights.back());
+    // The first value whose cumulative weight reaches the target.
+    auto it = std::lower_bound(cumulativeWeights.begin(), cumulativeWeights.end(), targetWeight, [](uint64_t cumulativeWeight, double targetWeight) {
+        return static_cast<double>(cumulativeWeight) < targetWeight;
+    });
+    
+    if (it == cumulativeWeights.end()) {
+        return maxValue;
+    }
+    
+    return values[it - cumulativeWeights.begin()];
+}
+
+/**
+ * @brief Gets the number of values added to the sketch.
+ * 
+ * @return The number of values.
+ */
+uint64_t KllSketch::getCount() const {
+    return count;
+}
+
+/**
+ * @brief Appends the sketch to a binary buffer.
+ * 
+ * @param out The buffer.
+ */
+void KllSketch::serialize(std::string &out) const {
+    appendBinary(out, k);
+    appendBinary(out, count);
+    appendBinary(out, minValue);
+    appendBinary(out, maxValue);
+    appendBinary(out, static_cast<uint32_t>(levels.size()));
+    
+    for (const std::vector<double> &level : levels) {
+        appendBinary(out, static_cast<uint32_t>(level.size()));
+        out.append(reinterpret_cast<const char *>(level.data()), level.size() * sizeof(double));
+    }
+}
+
+/**
+ * @brief Reads a sketch from a binary buffer.
+ * 
+ * Advances the string view to exclude the sketch.
+ * 
+ * @param in The buffer.
+ * @return The sketch.
+ */
+KllSketch KllSketch::deserialize(std::string_view &in) {
+    KllSketch sketch = KllSketch(readBinary<uint32_t>(in));
+    
+    sketch.count = readBinary<uint64_t>(in);
+    sketch.minValue = readBinary<double>(in);
+    sketch.maxValue = readBinary<double>(in);
+    
+    uint32_t levelCount = readBinary<uint32_t>(in);
+    
+    sketch.levels.clear();
+    
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        uint32_t levelSize = readBinary<uint32_t>(in);
+        std::string_view bytes = readBinaryBytes(in, levelSize * sizeof(double));
+        std::vector<double> level = std::vector<double>(levelSize);
+        
+        std::memcpy(level.data(), bytes.data(), bytes.length());
+        sketch.levels.push_back(std::move(level));
+    }
+    
+    if (sketch.levels.empty()) {
+        sketch.levels.emplace_back();
+    }
+    
+    return sketch;
+}
+
+/**
+ * @brief Creates an empty set of price quantile sketches.
+ * 
+ * @param preferredUnit The unit to price weighed items in.
+ * @param k The accuracy parameter for each sketch.
+ */
+PriceQuantiles::PriceQuantiles(Unit preferredUnit, uint32_t k) : preferredUnit(preferredUnit), k(k) {}
+
+/**
+ * @brief Adds the normalized unit price of an item to the sketch for its name.
+ * 
+ * @param shoppingListItem The shopping list item.
+ */
+void PriceQuantiles::add(const ShoppingListItem &shoppingListItem) {
+    uint32_t id = names.intern(shoppingListItem.name);
+    
+    if (id == sketches.size()) {
+        sketches.emplace_back(k);
+    }
+    
+    sketches[id].add(getShoppingListItemUnitPrice(shoppingListItem, preferredUnit));
+}
+
+/**
+ * @brief Merges another set of sketches into this one.
+ * 
+ * @param other The sketches to merge. Must use the same preferred unit.
+ */
+void PriceQuantiles::merge(const PriceQuantiles &other) {
+    if (other.preferredUnit != preferredUnit) {
+        throw std::runtime_error("Cannot merge price quantiles with different units");
+    }
+    
+    for (uint32_t otherId = 0; otherId < other.sketches.size(); ++otherId) {
+        uint32_t id = names.intern(other.names.getName(otherId));
+        
+        if (id == sketches.size()) {
+            sketches.emplace_back(k);
+        }
+        
+        sketches[id].merge(other.sketches[otherId]);
+    }
+}
+
+/**
+ * @brief Estimates a unit price quantile for an item.
+ * 
+ * @param name The name of the item.
+ * @param q The quantile between 0 and 1, e.g. 0.95 for p95.
+ * @return An optional containing the unit price in cents, or nothing if the item was never seen.
+ */
+std::optional<double> PriceQuantiles::getQuantile(const std::string_view &name, double q) const {
+    std::optional<uint32_t> idOpt = names.find(name);
+    
+    if (!idOpt.has_value()) {
+        return std::nullopt;
+    }
+    
+    return sketches[*idOpt].getQuantile(q);
+}
+
+/**
+ * @brief Gets the sorted view of the sketch for an item, for asking for several quantiles.
+ * 
+ * @param name The name of the item.
+ * @return An optional containing the view, or nothing if the item was never seen.
+ */
+std::optional<KllSortedView> PriceQuantiles::getSortedView(const std::string_view &name) const {
+    std::optional<uint32_t> idOpt = names.find(name);
+    
+    if (!idOpt.has_value()) {
+        return std::nullopt;
+    }
+    
+    return sketches[*idOpt].getSortedView();
+}
+
+/**
+ * @brief Gets the names of the items with sketches.
+ * 
+ * @return The names, by id.
+ */
+const NameInterner &PriceQuantiles::getNames() const {
+    return names;
+}
+
+/**
+ * @brief Gets the unit weighed items are priced in.
+ * 
+ * @return The unit.
+ */
+Unit PriceQuantiles::getPreferredUnit() const {
+    return preferredUnit;
+}
+
+/**
+ * @brief Serializes the sketches to a binary buffer.
+ * 
+ * @return The buffer.
+ */
+std::string PriceQuantiles::serialize() const {
+    std::string out;
+    
+    appendBinary(out, PRICE_QUANTILES_MAGIC);
+    appendBinary(out, static_cast<uint8_t>(preferredUnit));
+    appendBinary(out, k);
+    appendBinary(out, static_cast<uint32_t>(sketches.size()));
+    
+    for (uint32_t id = 0; id < sketches.size(); ++id) {
+        const std::string &name = names.getName(id);
+        
+        appendBinary(out, static_cast<uint32_t>(name.length()));
+        out.append(name);
+        sketches[id].serialize(out);
+    }
+    
+    return out;
+}
+
+/**
+ * @brief Reads sketches from a binary buffer.
+ * 
+ * @param in The buffer.
+ * @return The sketches.
+ */
+PriceQuantiles PriceQuantiles::deserialize(std::string_view in) {
+    if (readBinary<uint32_t>(in) != PRICE_QUANTILES_MAGIC) {
+        throw std::runtime_error("Not a price quantiles buffer");
+    }
+    
+    uint8_t unitValue = readBinary<uint8_t>(in);
+    
+    if (unitValue > static_cast<uint8_t>(Unit::Gram)) {
+        throw std::runtime_error("Invalid unit in price quantiles buffer");
+    }
+    
+    Unit preferredUnit = static_cast<Unit>(unitValue);
+    uint32_t k = readBinary<uint32_t>(in);
+    uint32_t sketchCount = readBinary<uint32_t>(in);
+    PriceQuantiles priceQuantiles = PriceQuantiles(preferredUnit, k);
+    
+    for (uint32_t i = 0; i < sketchCount; ++i) {
+        uint32_t nameLength = readBinary<uint32_t>(in);
+        
+        priceQuantiles.names.intern(readBinaryBytes(in, nameLength));
+        priceQuantiles.sketches.push_back(KllSketch::deserialize(in));
+    }
+    
+    return priceQuantiles;
+}
+
+/**
+ * @brief Builds price quantile sketches from shopping list text on a number of threads.
+ * 
+ * The text is split into chunks at line breaks. Each thread adds the unit price of every line it
+ * parses to its own sketches, and the sketches are merged once at the end.
+ * 
+ * @param content The shopping list text.
+ * @param preferredUnit The unit to price weighed items in.
+ * @param threadCount The number of threads.
+ * @param chunkSize The number of bytes of text each thread takes at a time. Chunks are extended
+ * to the end of their last line.
+ * @return The merged sketches.
+ */
+PriceQuantiles collectPriceQuantiles(const std::string_view &content, Unit preferredUnit, size_t threadCount, size_t chunkSize) {
+    std::vector<std::string_view> chunks = splitLineChunks(content, chunkSize);
+    
+    threadCount = std::max<size_t>(1, std::min(threadCount, chunks.size()));
+    
+    std::vector<PriceQuantiles> sketches = std::vector<PriceQuantiles>(threadCount, PriceQuantiles(preferredUnit));
+    
+    forEachChunkOnWorker(chunks.size(), threadCount, [&](size_t chunkIndex, size_t workerIndex) {
+        std::string_view remaining = chunks[chunkIndex];
+        std::string line;
+        
+        while (!remaining.empty()) {
+            size_t lineEnd = remaining.find('\n');
+            
+            line.assign(remaining.substr(0, lineEnd));
+            remaining = lineEnd == std::string_view::npos ? std::string_view() : remaining.substr(lineEnd + 1);
+            
+            if (line.empty() || startsWith(line, "//")) {
+                continue;
+            }
+            
+            try {
+                sketches[workerIndex].add(parseShoppingListItemStr(line));
+            } catch (std::runtime_error& e) {
+                // Ignore errors and continue to the next line.
+            }
+        }
+    });
+    
+    for (size_t i = 1; i < sketches.size(); ++i) {
+        sketches[0].merge(sketches[i]);
+    }
+    
+    return std::move(sketches[0]);
+}
+
+/**
+ * @brief Reads price quantile sketches from a file.
+ * 
+ * @param filePath The path to the file.
+ * @param preferredUnit The unit to price weighed items in if the file does not exist.
+ * @return The sketches, or empty sketches if the file does not exist.
+ */
+PriceQuantiles readPriceQuantiles(const std::string &filePath, Unit preferredUnit) {
+    std::ifstream file(filePath, std::ios::binary);
+    
+    if (!file.is_open()) {
+        return PriceQuantiles(preferredUnit);
+    }
+    
+    std::stringstream contents;
+    
+    contents << file.rdbuf();
+    
+    return PriceQuantiles::deserialize(contents.str());
+}
+
+/**
+ * @brief Writes price quantile sketches to a file, replacing it.
+ * 
+ * @param filePath The path to the file.
+ * @param priceQuantiles The sketches.
+ */
+void writePriceQuantiles(const std::string &filePath, const PriceQuantiles &priceQuantiles) {
+    replaceFile(filePath, priceQuantiles.serialize());
+}
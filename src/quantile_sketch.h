@@ -0,0 +1,104 @@
+/**
+ * @file quantile_sketch.h
+ * @author Julia
+ * @brief Declares mergeable quantile sketches for unit prices.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "unit.h"
+#include "interner.h"
+#include "shopping_list.h"
+#include "item_table.h"
+
+/// The values of a KLL sketch in order, with the weight up to each, for answering any number of
+/// quantile queries without sorting again.
+class KllSortedView {
+public:
+    std::optional<double> getQuantile(double q) const;
+
+private:
+    friend class KllSketch;
+    
+    /// The values in increasing order.
+    std::vector<double> values;
+    /// The total weight of each value and the values before it.
+    std::vector<uint64_t> cumulativeWeights;
+    /// The smallest value added to the sketch.
+    double minValue = 0;
+    /// The largest value added to the sketch.
+    double maxValue = 0;
+};
+
+/// A KLL sketch estimating quantiles of a stream of values.
+class KllSketch {
+public:
+    KllSketch(uint32_t k = 200);
+    
+    void add(double value);
+    void merge(const KllSketch &other);
+    KllSortedView getSortedView() const;
+    std::optional<double> getQuantile(double q) const;
+    uint64_t getCount() const;
+    void serialize(std::string &out) const;
+    static KllSketch deserialize(std::string_view &in);
+
+private:
+    uint32_t getLevelCapacity(size_t level) const;
+    void compress();
+    
+    /// Controls the accuracy of the sketch. The rank error is roughly 1.65 / k.
+    uint32_t k;
+    /// The number of values added.
+    uint64_t count = 0;
+    /// The smallest value added.
+    double minValue = 0;
+    /// The largest value added.
+    double maxValue = 0;
+    /// The compactors. Values at level h each stand for 2^h values.
+    std::vector<std::vector<double>> levels;
+    /// Alternates which half of each compaction is kept.
+    uint64_t coinState = 0x9e3779b97f4a7c15ULL;
+};
+
+/// Unit price quantile sketches keyed by interned item name.
+class PriceQuantiles {
+public:
+    PriceQuantiles(Unit preferredUnit = Unit::Pound, uint32_t k = 200);
+    
+    void add(const ShoppingListItem &shoppingListItem);
+    void merge(const PriceQuantiles &other);
+    std::optional<double> getQuantile(const std::string_view &name, double q) const;
+    std::optional<KllSortedView> getSortedView(const std::string_view &name) const;
+    const NameInterner &getNames() const;
+    Unit getPreferredUnit() const;
+    std::string serialize() const;
+    static PriceQuantiles deserialize(std::string_view in);
+
+private:
+    /// The unit weighed items are priced in.
+    Unit preferredUnit;
+    /// The accuracy parameter for new sketches.
+    uint32_t k;
+    /// The item names.
+    NameInterner names;
+    /// The sketches by name id.
+    std::vector<KllSketch> sketches;
+};
+
+PriceQuantiles collectPriceQuantiles(const std::string_view &content, Unit preferredUnit, size_t threadCount, size_t chunkSize = DEFAULT_PARSE_CHUNK_SIZE);
+PriceQuantiles readPriceQuantiles(const std::string &filePath, Unit preferredUnit);
+void writePriceQuantiles(const std::string &filePath, const PriceQuantiles &priceQuantiles);
+
+#endif
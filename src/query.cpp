@@ -0,0 +1,255 @@
+/**
+ * @file query.cpp
+ * @author Julia
+ * @brief Implements a query executor that filters, groups, ranks and totals items in one pass.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "unit.h"
+#include "utils.h"
+#include "shopping_list.h"
+#include "item_filter.h"
+#include "parallel.h"
+#include "query.h"
+
+/// The number of items each worker takes at a time.
+size_t const QUERY_CHUNK_SIZE = 16384;
+size_t const DEFAULT_QUERY_TEXT_CHUNK_SIZE = 1 << 20;
+
+/**
+ * @brief Orders groups by highest total first, then by key.
+ * 
+ * @param a The first group.
+ * @param b The second group.
+ * @return Whether a comes before b.
+ */
+bool isHigherGroup(const QueryGroup &a, const QueryGroup &b) {
+    if (a.totalPriceCents != b.totalPriceCents) {
+        return a.totalPriceCents > b.totalPriceCents;
+    }
+    
+    return a.key < b.key;
+}
+
+/**
+ * @brief Creates an empty pipeline.
+ * 
+ * @param query The query. Must outlive the pipeline.
+ */
+QueryPipeline::QueryPipeline(const Query &query) : query(query) {}
+
+/**
+ * @brief Pushes an item through the filter, the grouping and the totals.
+ * 
+ * @param shoppingListItem The item.
+ */
+void QueryPipeline::push(const ShoppingListItem &shoppingListItem) {
+    scannedCount++;
+    
+    if (!matchesItemFilter(shoppingListItem, query.filter)) {
+        return;
+    }
+    
+    int64_t itemTotalPriceCents = getShoppingListItemTotalPrice(shoppingListItem);
+    
+    matchedCount++;
+    totalPriceCents += itemTotalPriceCents;
+    
+    switch (query.groupBy) {
+        case GroupBy::None:
+            addGroup(QueryGroup {
+                .key = shoppingListItem.name,
+                .totalPriceCents = itemTotalPriceCents,
+                .itemCount = 1,
+            });
+            break;
+        case GroupBy::Name:
+        case GroupBy::PerUnitCountType: {
+            std::string key = query.groupBy == GroupBy::Name ?
+                normalizeItemName(shoppingListItem.name) :
+                convertCountTypeToString(shoppingListItem.perUnitCountType);
+            QueryGroup &group = groups[key];
+            
+            if (group.itemCount == 0) {
+                group.key = std::move(key);
+            }
+            
+            group.totalPriceCents += itemTotalPriceCents;
+            group.itemCount++;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Adds a candidate for the top groups, for queries that do not group items.
+ * 
+ * @param group The candidate.
+ */
+void QueryPipeline::addGroup(QueryGroup &&group) {
+    if (query.topCount == 0) {
+        return;
+    }
+    
+    topGroups.push_back(std::move(group));
+    
+    // Prune in batches so each candidate costs amortized constant time.
+    if (topGroups.size() >= 2 * query.topCount) {
+        pruneTopGroups();
+    }
+}
+
+/**
+ * @brief Keeps only the top groups among the candidates.
+ */
+void QueryPipeline::pruneTopGroups() {
+    if (topGroups.size() <= query.topCount) {
+        return;
+    }
+    
+    std::nth_element(topGroups.begin(), topGroups.begin() + query.topCount - 1, topGroups.end(), isHigherGroup);
+    topGroups.resize(query.topCount);
+}
+
+/**
+ * @brief Merges the state of another pipeline for the same query into this one.
+ * 
+ * @param other The pipeline to merge. It is left empty.
+ */
+void QueryPipeline::merge(QueryPipeline &&other) {
+    totalPriceCents += other.totalPriceCents;
+    matchedCount += other.matchedCount;
+    scannedCount += other.scannedCount;
+    
+    for (QueryGroup &group : other.topGroups) {
+        addGroup(std::move(group));
+    }
+    
+    for (auto &[key, otherGroup] : other.groups) {
+        QueryGroup &group = groups[key];
+        
+        if (group.itemCount == 0) {
+            group.key = key;
+        }
+        
+        group.totalPriceCents += otherGroup.totalPriceCents;
+        group.itemCount += otherGroup.itemCount;
+    }
+    
+    other.topGroups.clear();
+    other.groups.clear();
+}
+
+/**
+ * @brief Ranks the groups and returns the result.
+ * 
+ * @return The result.
+ */
+QueryResult QueryPipeline::finish() {
+    for (auto &[key, group] : groups) {
+        addGroup(std::move(group));
+    }
+    
+    groups.clear();
+    pruneTopGroups();
+    std::sort(topGroups.begin(), topGroups.end(), isHigherGroup);
+    
+    return QueryResult {
+        .topGroups = std::move(topGroups),
+        .totalPriceCents = totalPriceCents,
+        .matchedCount = matchedCount,
+        .scannedCount = scannedCount,
+    };
+}
+
+/**
+ * @brief Runs a query over parsed items.
+ * 
+ * Each worker pushes chunks of items through its own pipeline, and the pipelines are merged at
+ * the end, so no intermediate lists are built.
+ * 
+ * @param query The query.
+ * @param shoppingListItems The items.
+ * @param threadCount The number of threads.
+ * @return The result.
+ */
+QueryResult runQuery(const Query &query, const std::vector<ShoppingListItem> &shoppingListItems, size_t threadCount) {
+    size_t chunkCount = (shoppingListItems.size() + QUERY_CHUNK_SIZE - 1) / QUERY_CHUNK_SIZE;
+    std::vector<QueryPipeline> pipelines = std::vector<QueryPipeline>(chunkCount, QueryPipeline(query));
+    
+    forEachChunk(chunkCount, std::max<size_t>(1, threadCount), [&](size_t chunkIndex) {
+        size_t start = chunkIndex * QUERY_CHUNK_SIZE;
+        size_t end = std::min(start + QUERY_CHUNK_SIZE, shoppingListItems.size());
+        
+        for (size_t i = start; i < end; ++i) {
+            pipelines[chunkIndex].push(shoppingListItems[i]);
+        }
+    });
+    
+    QueryPipeline result = QueryPipeline(query);
+    
+    for (QueryPipeline &pipeline : pipelines) {
+        result.merge(std::move(pipeline));
+    }
+    
+    return result.finish();
+}
+
+/**
+ * @brief Parses shopping list text and runs a query over it in the same pass.
+ * 
+ * The text is split into chunks at line breaks. Each worker parses the lines of a chunk and pushes
+ * each item straight into its pipeline, so the items are never stored.
+ * 
+ * @param query The query.
+ * @param content The shopping list text.
+ * @param threadCount The number of threads.
+ * @param chunkSize The number of bytes of text each worker takes at a time. Chunks are extended
+ * to the end of their last line.
+ * @return The result.
+ */
+QueryResult runQueryOnText(const Query &query, const std::string_view &content, size_t threadCount, size_t chunkSize) {
+    std::vector<std::string_view> chunks = splitLineChunks(content, chunkSize);
+    
+    std::vector<QueryPipeline> pipelines = std::vector<QueryPipeline>(chunks.size(), QueryPipeline(query));
+    
+    forEachChunk(chunks.size(), std::max<size_t>(1, threadCount), [&](size_t chunkIndex) {
+        std::string_view remaining = chunks[chunkIndex];
+        std::string line;
+        
+        while (!remaining.empty()) {
+            size_t lineEnd = remaining.find('\n');
+            
+            line.assign(remaining.substr(0, lineEnd));
+            remaining = lineEnd == std::string_view::npos ? std::string_view() : remaining.substr(lineEnd + 1);
+            
+            if (line.empty() || startsWith(line, "//")) {
+                continue;
+            }
+            
+            try {
+                pipelines[chunkIndex].push(parseShoppingListItemStr(line));
+            } catch (std::runtime_error& e) {
+                // Ignore errors and continue to the next line.
+            }
+        }
+    });
+    
+    QueryPipeline result = QueryPipeline(query);
+    
+    for (QueryPipeline &pipeline : pipelines) {
+        result.merge(std::move(pipeline));
+    }
+    
+    return result.finish();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file query.h
+ * @author Julia
+ * @brief Declares a query executor that filters, groups, ranks and totals items in one pass.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef QUERY_H
+#define QUERY_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "shopping_list.h"
+#include "item_filter.h"
+
+/// The number of bytes of text each worker takes at a time by default.
+extern const size_t DEFAULT_QUERY_TEXT_CHUNK_SIZE;
+
+/// How to group items in a query.
+enum class GroupBy {
+    /// Each item is its own group.
+    None,
+    /// Items with the same normalized name form a group.
+    Name,
+    /// Items priced by the same CountType form a group.
+    PerUnitCountType
+};
+
+/// A query over shopping list items.
+struct Query {
+    /// The items to include.
+    ItemFilter filter;
+    /// How to group the included items.
+    GroupBy groupBy;
+    /// The number of groups with the highest totals to return.
+    size_t topCount;
+};
+
+/// A group of items in the result of a query.
+struct QueryGroup {
+    /// The key of the group, e.g. the normalized name.
+    std::string key;
+    /// The total price of the items in cents.
+    int64_t totalPriceCents;
+    /// The number of items.
+    size_t itemCount;
+};
+
+/// The result of a query.
+struct QueryResult {
+    /// The groups with the highest totals, highest first.
+    std::vector<QueryGroup> topGroups;
+    /// The total price of the included items in cents.
+    int64_t totalPriceCents;
+    /// The number of included items.
+    size_t matchedCount;
+    /// The number of items read.
+    size_t scannedCount;
+};
+
+/// Runs a query over items pushed to it one at a time, holding only the running state.
+class QueryPipeline {
+public:
+    QueryPipeline(const Query &query);
+    
+    void push(const ShoppingListItem &shoppingListItem);
+    void merge(QueryPipeline &&other);
+    QueryResult finish();
+
+private:
+    void addGroup(QueryGroup &&group);
+    void pruneTopGroups();
+    
+    /// The query.
+    const Query &query;
+    /// The groups so far, for queries that group items.
+    std::unordered_map<std::string, QueryGroup> groups;
+    /// The candidates for the top groups, for queries that do not group items.
+    std::vector<QueryGroup> topGroups;
+    /// The total price of the included items in cents.
+    int64_t totalPriceCents = 0;
+    /// The number of included items.
+    size_t matchedCount = 0;
+    /// The number of items read.
+    size_t scannedCount = 0;
+};
+
+QueryResult runQuery(const Query &query, const std::vector<ShoppingListItem> &shoppingListItems, size_t threadCount);
+QueryResult runQueryOnText(const Query &query, const std::string_view &content, size_t threadCount, size_t chunkSize = DEFAULT_QUERY_TEXT_CHUNK_SIZE);
+
+#endif
@@ -0,0 +1,338 @@
+/**
+ * @file recipe.cpp
+ * @author Julia
+ * @brief Implements expanding recipes and meal plans into shopping lists.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "unit.h"
+#include "utils.h"
+#include "shopping_list.h"
+#include "recipe.h"
+
+/// A reference to another recipe in a recipe.
+struct RecipeReference {
+    /// The name of the recipe.
+    std::string_view name;
+    /// The number of batches of the recipe.
+    double scale;
+};
+
+/// Adds up ingredients, merging items that are the same ingredient.
+class IngredientTotals {
+public:
+    /**
+     * @brief Adds an ingredient.
+     * 
+     * Weights of the same ingredient are converted to the unit it was first seen in. Ingredients
+     * are merged even when their prices differ, in which case the merged item is priced at the
+     * average price that gives the sum of their totals.
+     * 
+     * @param shoppingListItem The ingredient.
+     * @param scale The number of times to add it.
+     */
+    void add(const ShoppingListItem &shoppingListItem, double scale) {
+        std::optional<Unit> unitOpt = convertCountTypeToUnit(shoppingListItem.countType);
+        // Weighed and counted amounts cannot be added, so they are kept apart.
+        std::string key = normalizeItemName(shoppingListItem.name);
+        
+        key += unitOpt.has_value() ? "\nw" : "\nq";
+        
+        ShoppingListItem scaled = shoppingListItem;
+        
+        scaled.count *= scale;
+        
+        auto it = indexes.find(key);
+        
+        if (it == indexes.end()) {
+            indexes.emplace(std::move(key), items.size());
+            items.push_back(scaled);
+            totals.push_back(IngredientTotal {
+                .totalPriceCents = static_cast<double>(getShoppingListItemTotalPrice(scaled)),
+                .hasMixedPrices = false,
+            });
+            
+            return;
+        }
+        
+        ShoppingListItem &item = items[it->second];
+        IngredientTotal &total = totals[it->second];
+        double count = scaled.count;
+        
+        if (unitOpt.has_value()) {
+            count = convertWeight(count, *unitOpt, *convertCountTypeToUnit(item.countType));
+        }
+        
+        item.count += count;
+        total.totalPriceCents += getShoppingListItemTotalPrice(scaled);
+        total.hasMixedPrices = total.hasMixedPrices ||
+            item.priceCentsPerUnit != scaled.priceCentsPerUnit ||
+            item.perUnitCount != scaled.perUnitCount ||
+            item.perUnitCountType != scaled.perUnitCountType;
+    }
+    
+    /**
+     * @brief Takes the totals, in the order the ingredients were first seen.
+     * 
+     * @return The ingredients.
+     */
+    std::vector<ShoppingListItem> takeItems() {
+        for (size_t i = 0; i < items.size(); ++i) {
+            ShoppingListItem &item = items[i];
+            
+            if (!totals[i].hasMixedPrices || item.count <= 0) {
+                continue;
+            }
+            
+            // Price the whole amount at once, e.g. "$7.98 / 6 lb.", so the total is exact. Amounts
+            // that are not whole are priced per single unit instead.
+            bool isWholeCount = isWhole(item.count);
+            
+            item.perUnitCount = isWholeCount ? static_cast<int64_t>(item.count) : 1;
+            item.priceCentsPerUnit = std::llround(totals[i].totalPriceCents * item.perUnitCount / item.count);
+            item.perUnitCountType = item.countType;
+        }
+        
+        indexes.clear();
+        totals.clear();
+        
+        return std::move(items);
+    }
+
+private:
+    /// The price of a merged ingredient.
+    struct IngredientTotal {
+        /// The sum of the total prices of the merged items in cents.
+        double totalPriceCents;
+        /// Whether the merged items had different prices.
+        bool hasMixedPrices;
+    };
+    
+    /// The ingredients in the order they were first seen.
+    std::vector<ShoppingListItem> items;
+    /// The prices of the ingredients, by index in items.
+    std::vector<IngredientTotal> totals;
+    /// Maps ingredient keys to their index in items.
+    std::unordered_map<std::string, size_t> indexes;
+};
+
+/**
+ * @brief Parses a line that references another recipe, such as "@ Pizza Dough x 2".
+ * 
+ * @param line The line.
+ * @return An optional containing the reference, or nothing if the line is not a reference.
+ */
+std::optional<RecipeReference> parseRecipeReference(std::string_view line) {
+    if (!startsWithChar(line, '@')) {
+        return std::nullopt;
+    }
+    
+    line = line.substr(1);
+    trimFromFront(line);
+    trimFromBack(line);
+    
+    RecipeReference reference = RecipeReference {
+        .name = line,
+        .scale = 1,
+    };
+    size_t scalePos = line.rfind(" x ");
+    
+    if (scalePos != std::string_view::npos) {
+        std::string_view scaleStr = line.substr(scalePos + 3);
+        std::optional<double> scaleOpt = stringToDouble(scaleStr);
+        
+        if (!scaleOpt.has_value() || *scaleOpt < 0) {
+            throw std::runtime_error("Invalid recipe scale \"" + std::string(scaleStr) + "\"");
+        }
+        
+        std::string_view name = line.substr(0, scalePos);
+        
+        trimFromBack(name);
+        reference.name = name;
+        reference.scale = *scaleOpt;
+    }
+    
+    if (reference.name.empty()) {
+        throw std::runtime_error("Missing recipe name");
+    }
+    
+    return reference;
+}
+
+/**
+ * @brief Creates an empty recipe book.
+ * 
+ * @param directory The directory to load recipes from when they are referenced but have not been
+ * added. Empty to only use added recipes.
+ */
+RecipeBook::RecipeBook(const std::string &directory) : directory(directory) {}
+
+/**
+ * @brief Adds a recipe, replacing any recipe with the same name.
+ * 
+ * @param name The name of the recipe.
+ * @param content The lines of the recipe.
+ */
+void RecipeBook::addRecipe(const std::string &name, const std::string_view &content) {
+    recipes[normalizeItemName(name)] = Recipe {
+        .name = name,
+        .content = std::string(content),
+        .state = ExpansionState::Unexpanded,
+        .ingredients = {},
+    };
+    
+    // Expanded recipes may include the old version, so they are expanded again when next used.
+    for (auto &[key, recipe] : recipes) {
+        recipe.state = ExpansionState::Unexpanded;
+        recipe.ingredients.clear();
+    }
+}
+
+/**
+ * @brief Finds a recipe by name, loading it from the directory if it has not been added.
+ * 
+ * @param name The name of the recipe.
+ * @return The recipe.
+ */
+RecipeBook::Recipe &RecipeBook::findRecipe(const std::string_view &name) {
+    std::string key = normalizeItemName(name);
+    auto it = recipes.find(key);
+    
+    if (it != recipes.end()) {
+        return it->second;
+    }
+    
+    std::ifstream file;
+    
+    if (!directory.empty()) {
+        file.open(directory + "/" + std::string(name) + ".txt");
+    }
+    
+    if (!file.is_open()) {
+        throw std::runtime_error("Unknown recipe \"" + std::string(name) + "\"");
+    }
+    
+    std::stringstream contents;
+    
+    contents << file.rdbuf();
+    
+    return recipes[key] = Recipe {
+        .name = std::string(name),
+        .content = contents.str(),
+        .state = ExpansionState::Unexpanded,
+        .ingredients = {},
+    };
+}
+
+/**
+ * @brief Gets the consolidated ingredients for a single batch of a recipe.
+ * 
+ * The recipe and the recipes it references are each parsed and expanded once; later calls reuse
+ * the result.
+ * 
+ * @param name The name of the recipe.
+ * @return The ingredients, in the order they were first seen.
+ */
+const std::vector<ShoppingListItem> &RecipeBook::getIngredients(const std::string_view &name) {
+    Recipe &recipe = findRecipe(name);
+    
+    if (recipe.state == ExpansionState::Expanded) {
+        return recipe.ingredients;
+    }
+    
+    if (recipe.state == ExpansionState::Expanding) {
+        throw std::runtime_error("Recipe \"" + recipe.name + "\" includes itself");
+    }
+    
+    recipe.state = ExpansionState::Expanding;
+    
+    try {
+        recipe.ingredients = expand(recipe.content);
+    } catch (std::runtime_error& e) {
+        recipe.state = ExpansionState::Unexpanded;
+        
+        // Name the recipe once, at the innermost recipe that failed.
+        if (startsWith(e.what(), "In recipe ")) {
+            throw;
+        }
+        
+        throw std::runtime_error("In recipe \"" + recipe.name + "\": " + e.what());
+    }
+    
+    recipe.state = ExpansionState::Expanded;
+    
+    return recipe.ingredients;
+}
+
+/**
+ * @brief Expands lines written like a recipe, such as a meal plan, into a shopping list.
+ * 
+ * Throws if a line cannot be parsed, so a mistyped ingredient is not silently left off the list.
+ * 
+ * @param content The lines.
+ * @return The consolidated ingredients, in the order they were first seen.
+ */
+std::vector<ShoppingListItem> RecipeBook::expand(const std::string_view &content) {
+    IngredientTotals totals;
+    std::string_view remaining = content;
+    
+    while (!remaining.empty()) {
+        size_t lineEnd = remaining.find('\n');
+        std::string_view line = remaining.substr(0, lineEnd);
+        
+        remaining = lineEnd == std::string_view::npos ? std::string_view() : remaining.substr(lineEnd + 1);
+        trimFromFront(line);
+        trimFromBack(line);
+        
+        if (line.empty() || startsWith(line, "//")) {
+            continue;
+        }
+        
+        std::optional<RecipeReference> referenceOpt = parseRecipeReference(line);
+        
+        if (referenceOpt.has_value()) {
+            for (const ShoppingListItem &ingredient : getIngredients(referenceOpt->name)) {
+                totals.add(ingredient, referenceOpt->scale);
+            }
+            
+            continue;
+        }
+        
+        try {
+            totals.add(parseShoppingListItemStr(std::string(line)), 1);
+        } catch (std::runtime_error& e) {
+            throw std::runtime_error("Failed to parse line \"" + std::string(line) + "\": " + e.what());
+        }
+    }
+    
+    return totals.takeItems();
+}
+
+/**
+ * @brief Gets the number of recipes that have been expanded and are ready to reuse.
+ * 
+ * @return The number of recipes.
+ */
+size_t RecipeBook::getExpandedCount() const {
+    size_t expandedCount = 0;
+    
+    for (const auto &[key, recipe] : recipes) {
+        if (recipe.state == ExpansionState::Expanded) {
+            expandedCount++;
+        }
+    }
+    
+    return expandedCount;
+}
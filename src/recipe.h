@@ -0,0 +1,65 @@
+/**
+ * @file recipe.h
+ * @author Julia
+ * @brief Declares expanding recipes and meal plans into shopping lists.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef RECIPE_H
+#define RECIPE_H
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "shopping_list.h"
+
+/// Recipes by name, each expanded into its ingredients at most once.
+///
+/// A recipe is written like a shopping list. A line such as "@ Pizza Dough x 2" adds the
+/// ingredients of another recipe, scaled by the factor after the "x".
+class RecipeBook {
+public:
+    RecipeBook(const std::string &directory = "");
+    
+    void addRecipe(const std::string &name, const std::string_view &content);
+    const std::vector<ShoppingListItem> &getIngredients(const std::string_view &name);
+    std::vector<ShoppingListItem> expand(const std::string_view &content);
+    size_t getExpandedCount() const;
+
+private:
+    /// The progress of expanding a recipe.
+    enum class ExpansionState {
+        /// Not expanded yet.
+        Unexpanded,
+        /// Being expanded. Seeing it again means the recipes form a cycle.
+        Expanding,
+        /// Expanded; the ingredients are ready.
+        Expanded
+    };
+    
+    /// A recipe and its expanded ingredients.
+    struct Recipe {
+        /// The name as it was first given.
+        std::string name;
+        /// The lines of the recipe.
+        std::string content;
+        /// The progress of expanding the recipe.
+        ExpansionState state;
+        /// The consolidated ingredients for a single batch of the recipe.
+        std::vector<ShoppingListItem> ingredients;
+    };
+    
+    Recipe &findRecipe(const std::string_view &name);
+    
+    /// The directory to load recipes from when they have not been added, as "<name>.txt".
+    std::string directory;
+    /// The recipes by normalized name.
+    std::unordered_map<std::string, Recipe> recipes;
+};
+
+#endif
@@ -0,0 +1,477 @@
+/**
+ * @file report_template.cpp
+ * @author Julia
+ * @brief Implements user-defined report layouts compiled into formatting ops.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * Templates are made of literal text and placeholders of the form {field:<width|modifier}, e.g.
+ * "{name:<20}{count:>10|kg}{total:>10|plain}". The alignment is one of '<', '>' or '^', and the
+ * modifier is either a unit (oz, lb, kg, g) or a money format (locale, grouped, plain, cents).
+ * Use "{{" and "}}" for literal braces.
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include "unit.h"
+#include "utils.h"
+#include "format.h"
+#include "shopping_list.h"
+#include "buffered_writer.h"
+#include "running_total.h"
+#include "parallel.h"
+#include "display_width.h"
+#include "report_template.h"
+
+const char *const DEFAULT_REPORT_TEMPLATE = "{name:<20}{count:<10}{total:<10}{per_unit:<24}";
+const char *const RUNNING_TOTAL_REPORT_TEMPLATE = "{name:<20}{count:<10}{total:<10}{per_unit:<24}{running:>12}";
+
+/// Lists with fewer items than this are measured on the calling thread.
+size_t const PARALLEL_FIT_MIN_ITEMS = 1 << 16;
+
+/**
+ * @brief Converts a field name to a field.
+ * 
+ * @param s The field name.
+ * @return The field.
+ */
+TemplateField parseTemplateField(const std::string_view &s) {
+    if (s == "name") {
+        return TemplateField::Name;
+    } else if (s == "count") {
+        return TemplateField::Count;
+    } else if (s == "total") {
+        return TemplateField::Total;
+    } else if (s == "per_unit") {
+        return TemplateField::PerUnit;
+    } else if (s == "unit_price") {
+        return TemplateField::UnitPrice;
+    } else if (s == "running") {
+        return TemplateField::RunningTotal;
+    }
+    
+    throw std::runtime_error("Unknown template field \"" + std::string(s) + "\"");
+}
+
+/**
+ * @brief Converts a modifier to a money format.
+ * 
+ * @param s The modifier.
+ * @return An optional containing the money format if the modifier is one.
+ */
+std::optional<MoneyFormat> parseMoneyFormat(const std::string_view &s) {
+    if (s == "locale") {
+        return MoneyFormat::Locale;
+    } else if (s == "grouped") {
+        return MoneyFormat::Grouped;
+    } else if (s == "plain") {
+        return MoneyFormat::Plain;
+    } else if (s == "cents") {
+        return MoneyFormat::Cents;
+    }
+    
+    return std::nullopt;
+}
+
+/**
+ * @brief Appends literal text to the ops, merging it with a preceding literal.
+ * 
+ * @param ops The ops.
+ * @param text The literal text.
+ */
+void appendLiteralOp(std::vector<FormatOp> &ops, const std::string_view &text) {
+    if (!ops.empty() && ops.back().field == TemplateField::Literal) {
+        ops.back().literal.append(text.data(), text.length());
+        return;
+    }
+    
+    ops.push_back(FormatOp {
+        .field = TemplateField::Literal,
+        .alignment = Alignment::Left,
+        .width = 0,
+        .unit = Unit::Pound,
+        .moneyFormat = MoneyFormat::Grouped,
+        .literal = std::string(text),
+    });
+}
+
+/**
+ * @brief Compiles a placeholder, e.g. "total:>10|plain".
+ * 
+ * @param placeholder The text between the braces.
+ * @param preferredUnit The unit to use when no unit is given.
+ * @param moneyFormat The money format to use when none is given.
+ * @return The compiled op.
+ */
+FormatOp compilePlaceholder(std::string_view placeholder, Unit preferredUnit, MoneyFormat moneyFormat) {
+    FormatOp op = FormatOp {
+        .field = TemplateField::Literal,
+        .alignment = Alignment::Left,
+        .width = 0,
+        .unit = preferredUnit,
+        .moneyFormat = moneyFormat,
+        .literal = "",
+    };
+    
+    size_t modifierPos = placeholder.find('|');
+    
+    if (modifierPos != std::string_view::npos) {
+        std::string_view modifier = placeholder.substr(modifierPos + 1);
+        std::optional<Unit> unitOpt = convertStringToUnit(modifier);
+        std::optional<MoneyFormat> moneyFormatOpt = parseMoneyFormat(modifier);
+        
+        if (unitOpt.has_value()) {
+            op.unit = *unitOpt;
+        } else if (moneyFormatOpt.has_value()) {
+            op.moneyFormat = *moneyFormatOpt;
+        } else {
+            throw std::runtime_error("Unknown template modifier \"" + std::string(modifier) + "\"");
+        }
+        
+        placeholder = placeholder.substr(0, modifierPos);
+    }
+    
+    size_t specPos = placeholder.find(':');
+    
+    op.field = parseTemplateField(placeholder.substr(0, specPos));
+    
+    if (specPos == std::string_view::npos) {
+        return op;
+    }
+    
+    std::string_view spec = placeholder.substr(specPos + 1);
+    
+    if (startsWithChar(spec, '<')) {
+        op.alignment = Alignment::Left;
+        spec = spec.substr(1);
+    } else if (startsWithChar(spec, '>')) {
+        op.alignment = Alignment::Right;
+        spec = spec.substr(1);
+    } else if (startsWithChar(spec, '^')) {
+        op.alignment = Alignment::Center;
+        spec = spec.substr(1);
+    }
+    
+    if (!spec.empty()) {
+        std::optional<int64_t> widthOpt = stringToInt(std::string(spec));
+        
+        if (!widthOpt.has_value() || *widthOpt < 0 || spec.find_first_not_of("0123456789") != std::string_view::npos) {
+            throw std::runtime_error("Invalid template width \"" + std::string(spec) + "\"");
+        }
+        
+        op.width = static_cast<uint32_t>(*widthOpt);
+    }
+    
+    return op;
+}
+
+/**
+ * @brief Compiles a report template into formatting ops.
+ * 
+ * The template is parsed once so rendering a row is a flat loop over the ops.
+ * 
+ * @param templateStr The template.
+ * @param preferredUnit The unit to use for fields without a unit modifier.
+ * @param moneyFormat The money format to use for fields without a money format modifier.
+ * @return The compiled template.
+ */
+ReportTemplate compileReportTemplate(const std::string_view &templateStr, Unit preferredUnit, MoneyFormat moneyFormat) {
+    ReportTemplate reportTemplate;
+    size_t i = 0;
+    
+    while (i < templateStr.length()) {
+        char c = templateStr[i];
+        
+        if (c == '{' && i + 1 < templateStr.length() && templateStr[i + 1] == '{') {
+            appendLiteralOp(reportTemplate.ops, "{");
+            i += 2;
+        } else if (c == '}' && i + 1 < templateStr.length() && templateStr[i + 1] == '}') {
+            appendLiteralOp(reportTemplate.ops, "}");
+            i += 2;
+        } else if (c == '{') {
+            size_t end = templateStr.find('}', i);
+            
+            if (end == std::string_view::npos) {
+                throw std::runtime_error("Unterminated template placeholder");
+            }
+            
+            std::string_view placeholder = templateStr.substr(i + 1, end - i - 1);
+            
+            reportTemplate.ops.push_back(compilePlaceholder(placeholder, preferredUnit, moneyFormat));
+            i = end + 1;
+        } else if (c == '}') {
+            throw std::runtime_error("Unexpected \"}\" in template");
+        } else {
+            // Take the literal text up to the next brace.
+            size_t end = templateStr.find_first_of("{}", i);
+            
+            if (end == std::string_view::npos) {
+                end = templateStr.length();
+            }
+            
+            appendLiteralOp(reportTemplate.ops, templateStr.substr(i, end - i));
+            i = end;
+        }
+    }
+    
+    return reportTemplate;
+}
+
+/**
+ * @brief Formats a price with a currency symbol.
+ * 
+ * @param cents The price in cents.
+ * @param moneyFormat The format to use.
+ * @return The formatted price.
+ */
+std::string formatPrice(int64_t cents, MoneyFormat moneyFormat) {
+    if (moneyFormat == MoneyFormat::Cents) {
+        return formatMoney(cents, moneyFormat);
+    }
+    
+    return "$" + formatMoney(cents, moneyFormat);
+}
+
+/**
+ * @brief Converts a string to a column layout.
+ * 
+ * @param s The string: "bytes", "width" or "auto".
+ * @return An optional containing the layout, or nothing if the string is not one.
+ */
+std::optional<ColumnLayout> convertStringToColumnLayout(const std::string_view &s) {
+    if (s == "bytes") {
+        return ColumnLayout::Bytes;
+    } else if (s == "width") {
+        return ColumnLayout::DisplayWidth;
+    } else if (s == "auto") {
+        return ColumnLayout::Auto;
+    }
+    
+    return std::nullopt;
+}
+
+/**
+ * @brief Appends the value of a field without padding.
+ * 
+ * @param out The output.
+ * @param op The op for the column. Must not be a literal.
+ * @param shoppingListItem The shopping list item.
+ * @param runningTotalCents The running total including this item.
+ */
+void appendFieldValue(std::string &out, const FormatOp &op, const ShoppingListItem &shoppingListItem, int64_t runningTotalCents) {
+    switch (op.field) {
+        case TemplateField::Literal:
+            out += op.literal;
+            break;
+        case TemplateField::Name:
+            out += shoppingListItem.name;
+            break;
+        case TemplateField::Count:
+            out += formatCountColumn(shoppingListItem, op.unit);
+            break;
+        case TemplateField::Total:
+            out += formatPrice(getShoppingListItemTotalPrice(shoppingListItem), op.moneyFormat);
+            break;
+        case TemplateField::PerUnit:
+            out += formatPerUnitColumn(shoppingListItem, op.unit, op.moneyFormat);
+            break;
+        case TemplateField::UnitPrice: {
+            double unitPrice = getShoppingListItemUnitPrice(shoppingListItem, op.unit);
+            
+            out += formatPrice(std::llround(unitPrice), op.moneyFormat);
+            break;
+        }
+        case TemplateField::RunningTotal:
+            out += formatPrice(runningTotalCents, op.moneyFormat);
+            break;
+    }
+}
+
+/**
+ * @brief Pads the value at the end of the output to the width of its column.
+ * 
+ * @param out The output.
+ * @param valueStart The position of the value in the output.
+ * @param op The op for the column.
+ * @param layout How to measure the value.
+ */
+void padColumn(std::string &out, size_t valueStart, const FormatOp &op, ColumnLayout layout) {
+    size_t valueWidth = out.length() - valueStart;
+    
+    if (layout != ColumnLayout::Bytes) {
+        valueWidth = getDisplayWidth(std::string_view(out).substr(valueStart));
+    }
+    
+    size_t padding = valueWidth < op.width ? op.width - valueWidth : 0;
+    
+    if (padding == 0) {
+        return;
+    }
+    
+    switch (op.alignment) {
+        case Alignment::Left:
+            out.append(padding, ' ');
+            break;
+        case Alignment::Right:
+            out.insert(valueStart, padding, ' ');
+            break;
+        case Alignment::Center:
+            out.insert(valueStart, padding / 2, ' ');
+            out.append(padding - padding / 2, ' ');
+            break;
+    }
+}
+
+/**
+ * @brief Checks whether a template has a running total column.
+ * 
+ * @param reportTemplate The compiled template.
+ * @return Whether the rows need running totals.
+ */
+bool hasRunningTotal(const ReportTemplate &reportTemplate) {
+    for (const FormatOp &op : reportTemplate.ops) {
+        if (op.field == TemplateField::RunningTotal) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Sizes the columns of a template with the auto layout from the data.
+ * 
+ * This is the first pass of the auto layout: every value is measured, and each column is widened
+ * to leave a space after its longest value. Columns are never narrowed below their template
+ * width. The items are measured in blocks across threads, and the widest value of each column
+ * is then taken across the blocks.
+ * 
+ * @param reportTemplate The compiled template.
+ * @param shoppingListItems The shopping list items that will be rendered.
+ * @param runningTotals The running totals of the items, or empty if the template has no running
+ * total column.
+ * @param threadCount The number of threads.
+ * @return The template with its columns sized and measured by display width, or the template
+ * unchanged if it does not use the auto layout.
+ */
+ReportTemplate fitReportTemplate(const ReportTemplate &reportTemplate, const std::vector<ShoppingListItem> &shoppingListItems, const std::vector<int64_t> &runningTotals, size_t threadCount) {
+    if (reportTemplate.layout != ColumnLayout::Auto) {
+        return reportTemplate;
+    }
+    
+    ReportTemplate fitted = reportTemplate;
+    size_t itemCount = shoppingListItems.size();
+    size_t blockCount = itemCount < PARALLEL_FIT_MIN_ITEMS ? 1 : std::max<size_t>(1, threadCount);
+    size_t blockSize = (itemCount + blockCount - 1) / blockCount;
+    // The widest value of each column in each block.
+    std::vector<std::vector<size_t>> blockWidths = std::vector<std::vector<size_t>>(blockCount, std::vector<size_t>(fitted.ops.size(), 0));
+    
+    fitted.layout = ColumnLayout::DisplayWidth;
+    
+    forEachChunk(blockCount, threadCount, [&](size_t blockIndex) {
+        size_t start = std::min(blockIndex * blockSize, itemCount);
+        size_t end = std::min(start + blockSize, itemCount);
+        std::vector<size_t> &widths = blockWidths[blockIndex];
+        std::string value;
+        
+        for (size_t i = start; i < end; ++i) {
+            int64_t runningTotalCents = runningTotals.empty() ? 0 : runningTotals[i];
+            
+            for (size_t j = 0; j < fitted.ops.size(); ++j) {
+                const FormatOp &op = fitted.ops[j];
+                
+                if (op.field == TemplateField::Literal) {
+                    continue;
+                }
+                
+                if (op.field == TemplateField::Name) {
+                    widths[j] = std::max(widths[j], getDisplayWidth(shoppingListItems[i].name));
+                    continue;
+                }
+                
+                value.clear();
+                appendFieldValue(value, op, shoppingListItems[i], runningTotalCents);
+                widths[j] = std::max(widths[j], getDisplayWidth(value));
+            }
+        }
+    });
+    
+    std::vector<size_t> widths = std::vector<size_t>(fitted.ops.size(), 0);
+    
+    for (const std::vector<size_t> &blockWidth : blockWidths) {
+        for (size_t j = 0; j < fitted.ops.size(); ++j) {
+            widths[j] = std::max(widths[j], blockWidth[j]);
+        }
+    }
+    
+    for (size_t j = 0; j < fitted.ops.size(); ++j) {
+        FormatOp &op = fitted.ops[j];
+        
+        if (op.field != TemplateField::Literal && !shoppingListItems.empty()) {
+            op.width = std::max<uint32_t>(op.width, static_cast<uint32_t>(widths[j] + 1));
+        }
+    }
+    
+    return fitted;
+}
+
+/**
+ * @brief Renders a row for an item by executing the compiled ops.
+ * 
+ * Templates with the auto layout are measured by display width but keep their template widths;
+ * fit them with fitReportTemplate first to size the columns from the data.
+ * 
+ * @param reportTemplate The compiled template.
+ * @param shoppingListItem The shopping list item.
+ * @param out The output to append the row and a newline to.
+ * @param runningTotalCents The running total including this item, for templates with a running
+ * total column.
+ */
+void renderReportRow(const ReportTemplate &reportTemplate, const ShoppingListItem &shoppingListItem, std::string &out, int64_t runningTotalCents) {
+    for (const FormatOp &op : reportTemplate.ops) {
+        if (op.field == TemplateField::Literal) {
+            out += op.literal;
+            continue;
+        }
+        
+        size_t valueStart = out.length();
+        
+        appendFieldValue(out, op, shoppingListItem, runningTotalCents);
+        padColumn(out, valueStart, op, reportTemplate.layout);
+    }
+    
+    out += '\n';
+}
+
+/**
+ * @brief Renders a row for every item.
+ * 
+ * @param reportTemplate The compiled template.
+ * @param shoppingListItems The shopping list items.
+ * @param writer The writer to render into.
+ * @param threadCount The number of threads to compute running totals with.
+ */
+void renderReport(const ReportTemplate &reportTemplate, const std::vector<ShoppingListItem> &shoppingListItems, BufferedWriter &writer, size_t threadCount) {
+    std::vector<int64_t> runningTotals;
+    
+    if (hasRunningTotal(reportTemplate)) {
+        runningTotals = computeRunningTotals(shoppingListItems, threadCount);
+    }
+    
+    ReportTemplate fitted = fitReportTemplate(reportTemplate, shoppingListItems, runningTotals, threadCount);
+    
+    for (size_t i = 0; i < shoppingListItems.size(); ++i) {
+        int64_t runningTotalCents = runningTotals.empty() ? 0 : runningTotals[i];
+        
+        renderReportRow(fitted, shoppingListItems[i], writer.getBuffer(), runningTotalCents);
+        writer.flushIfFull();
+    }
+}
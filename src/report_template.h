@@ -0,0 +1,99 @@
+/**
+ * @file report_template.h
+ * @author Julia
+ * @brief Declares user-defined report layouts compiled into formatting ops.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef REPORT_TEMPLATE_H
+#define REPORT_TEMPLATE_H
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "unit.h"
+#include "format.h"
+#include "shopping_list.h"
+#include "buffered_writer.h"
+
+/// The template used when none is given. Matches the layout of printShoppingListItem.
+extern const char *const DEFAULT_REPORT_TEMPLATE;
+/// The default template with a running total column.
+extern const char *const RUNNING_TOTAL_REPORT_TEMPLATE;
+
+/// A value that can be placed in a report row.
+enum class TemplateField {
+    /// Literal text from the template.
+    Literal,
+    /// The name of the item.
+    Name,
+    /// The count of the item, e.g. "2 lb.".
+    Count,
+    /// The total price of the item.
+    Total,
+    /// The price per unit, e.g. "@ $4.99 / lb.".
+    PerUnit,
+    /// The normalized price for one unit or one item.
+    UnitPrice,
+    /// The total price of the item and every item before it.
+    RunningTotal
+};
+
+/// Alignment of a value within its column.
+enum class Alignment {
+    /// Padded on the right.
+    Left,
+    /// Padded on the left.
+    Right,
+    /// Padded on both sides.
+    Center
+};
+
+/// How the widths of columns are measured.
+enum class ColumnLayout {
+    /// Widths count bytes. The fastest, and exact for ASCII text.
+    Bytes,
+    /// Widths count terminal columns, so accented and wide characters line up.
+    DisplayWidth,
+    /// Widths count terminal columns, and columns are widened to fit the longest value.
+    Auto
+};
+
+/// A single compiled formatting step.
+struct FormatOp {
+    /// The value to output.
+    TemplateField field;
+    /// The alignment within the column.
+    Alignment alignment;
+    /// The minimum width of the column. 0 for no padding.
+    uint32_t width;
+    /// The unit for weights and unit prices.
+    Unit unit;
+    /// The format for prices.
+    MoneyFormat moneyFormat;
+    /// The text to output for literals.
+    std::string literal;
+};
+
+/// A compiled report template.
+struct ReportTemplate {
+    /// The formatting steps for a row, in order.
+    std::vector<FormatOp> ops;
+    /// How the widths of columns are measured.
+    ColumnLayout layout = ColumnLayout::Bytes;
+};
+
+ReportTemplate compileReportTemplate(const std::string_view &templateStr, Unit preferredUnit = Unit::Pound, MoneyFormat moneyFormat = MoneyFormat::Grouped);
+std::optional<ColumnLayout> convertStringToColumnLayout(const std::string_view &s);
+bool hasRunningTotal(const ReportTemplate &reportTemplate);
+ReportTemplate fitReportTemplate(const ReportTemplate &reportTemplate, const std::vector<ShoppingListItem> &shoppingListItems, const std::vector<int64_t> &runningTotals, size_t threadCount = 1);
+void renderReportRow(const ReportTemplate &reportTemplate, const ShoppingListItem &shoppingListItem, std::string &out, int64_t runningTotalCents = 0);
+void renderReport(const ReportTemplate &reportTemplate, const std::vector<ShoppingListItem> &shoppingListItems, BufferedWriter &writer, size_t threadCount = 1);
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * @file running_total.cpp
+ * @author Julia
+ * @brief Implements computing running totals of shopping list items.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "shopping_list.h"
+#include "parallel.h"
+#include "running_total.h"
+
+/// Lists with fewer items than this are summed on the calling thread.
+size_t const PARALLEL_RUNNING_TOTAL_MIN_ITEMS = 1 << 16;
+
+/**
+ * @brief Computes the running total after every item.
+ * 
+ * Large lists use a two-pass parallel prefix sum. The first pass splits the items into one block
+ * per thread and computes the running totals within each block. The block sums are then added up
+ * in order, and the second pass adds the sum of the blocks before each block to its totals.
+ * 
+ * @param shoppingListItems The shopping list items.
+ * @param threadCount The number of threads.
+ * @return The total price in cents of each item and every item before it.
+ */
+std::vector<int64_t> computeRunningTotals(const std::vector<ShoppingListItem> &shoppingListItems, size_t threadCount) {
+    size_t itemCount = shoppingListItems.size();
+    std::vector<int64_t> runningTotals = std::vector<int64_t>(itemCount);
+    
+    if (itemCount < PARALLEL_RUNNING_TOTAL_MIN_ITEMS || threadCount <= 1) {
+        int64_t runningTotal = 0;
+        
+        for (size_t i = 0; i < itemCount; ++i) {
+            runningTotal += getShoppingListItemTotalPrice(shoppingListItems[i]);
+            runningTotals[i] = runningTotal;
+        }
+        
+        return runningTotals;
+    }
+    
+    size_t blockCount = threadCount;
+    size_t blockSize = (itemCount + blockCount - 1) / blockCount;
+    std::vector<int64_t> blockOffsets = std::vector<int64_t>(blockCount, 0);
+    
+    // Sum within each block.
+    forEachChunk(blockCount, threadCount, [&](size_t blockIndex) {
+        size_t start = std::min(blockIndex * blockSize, itemCount);
+        size_t end = std::min(start + blockSize, itemCount);
+        int64_t runningTotal = 0;
+        
+        for (size_t i = start; i < end; ++i) {
+            runningTotal += getShoppingListItemTotalPrice(shoppingListItems[i]);
+            runningTotals[i] = runningTotal;
+        }
+    });
+    
+    // Each block starts from the sum of the blocks before it.
+    for (size_t blockIndex = 1; blockIndex < blockCount; ++blockIndex) {
+        size_t previousEnd = std::min(blockIndex * blockSize, itemCount);
+        int64_t previousSum = previousEnd > 0 ? runningTotals[previousEnd - 1] : 0;
+        
+        blockOffsets[blockIndex] = blockOffsets[blockIndex - 1] + previousSum;
+    }
+    
+    forEachChunk(blockCount, threadCount, [&](size_t blockIndex) {
+        size_t start = std::min(blockIndex * blockSize, itemCount);
+        size_t end = std::min(start + blockSize, itemCount);
+        
+        for (size_t i = start; i < end; ++i) {
+            runningTotals[i] += blockOffsets[blockIndex];
+        }
+    });
+    
+    return runningTotals;
+}
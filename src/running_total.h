@@ -0,0 +1,21 @@
+/**
+ * @file running_total.h
+ * @author Julia
+ * @brief Declares computing running totals of shopping list items.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef RUNNING_TOTAL_H
+#define RUNNING_TOTAL_H
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "shopping_list.h"
+
+std::vector<int64_t> computeRunningTotals(const std::vector<ShoppingListItem> &shoppingListItems, size_t threadCount);
+
+#endif
@@ -0,0 +1,793 @@
+/**
+ * @file scaling.cpp
+ * @author Julia
+ * @brief Implements a harness that measures how the parallel paths scale across parameters.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "unit.h"
+#include "utils.h"
+#include "buffered_writer.h"
+#include "item_table.h"
+#include "parse_controller.h"
+#include "partition.h"
+#include "parallel.h"
+#include "query.h"
+#include "scaling.h"
+
+/// The item names used in generated corpora.
+const char *const CORPUS_NAMES[] = {
+    "Chicken Breasts", "Sweet Corn", "Corn Chex", "Milk", "Eggs", "Flour",
+    "Bananas", "Coffee", "Jasmine Rice", "Butter", "Greek Yogurt", "Paper Towels",
+};
+/// Words appended to names in corpora with long lines.
+const char *const CORPUS_WORDS[] = {
+    "organic", "family", "size", "value", "pack", "low", "sodium", "extra", "large", "fresh",
+};
+/// The CSV header, matching the columns of formatSampleCsv.
+const char *const SCALING_CSV_HEADER = "workload,line_mix,lines,bytes,threads,chunk_size,repetition,checksum,wall_seconds,mb_per_second,lines_per_second,cpu_seconds,cpu_utilization,max_rss_kb";
+
+/// The result a measuring child process sends back to the harness.
+struct ChildMeasurement {
+    /// Whether the task finished without an error.
+    bool isOk;
+    /// The value the task returned.
+    size_t checksum;
+    /// The elapsed time in seconds.
+    double wallSeconds;
+    /// The user and system CPU time in seconds.
+    double cpuSeconds;
+    /// The peak resident memory in kilobytes.
+    int64_t maxRssKilobytes;
+};
+
+/**
+ * @brief Gets the next value of a xorshift sequence.
+ * 
+ * @param state The state of the sequence. Must not be 0.
+ * @return The next value.
+ */
+uint64_t nextRandom(uint64_t &state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    
+    return state;
+}
+
+/**
+ * @brief Appends a random price such as "4.99" without a currency symbol.
+ * 
+ * @param out The output.
+ * @param state The random state.
+ */
+void appendRandomPrice(std::string &out, uint64_t &state) {
+    char buffer[32];
+    uint64_t cents = 25 + nextRandom(state) % 2000;
+    int length = std::snprintf(buffer, sizeof(buffer), "%llu.%02llu", static_cast<unsigned long long>(cents / 100), static_cast<unsigned long long>(cents % 100));
+    
+    out.append(buffer, static_cast<size_t>(length));
+}
+
+/**
+ * @brief Appends one generated line and a newline.
+ * 
+ * @param out The output.
+ * @param lineMix The shape of the line. Mixed picks one of the others or a non-item line.
+ * @param state The random state.
+ */
+void appendCorpusLine(std::string &out, LineMix lineMix, uint64_t &state) {
+    const char *name = CORPUS_NAMES[nextRandom(state) % std::size(CORPUS_NAMES)];
+    
+    if (lineMix == LineMix::Mixed) {
+        uint64_t pick = nextRandom(state) % 50;
+        
+        if (pick == 0) {
+            out += "// Aisle " + std::to_string(nextRandom(state) % 20) + "\n";
+            return;
+        } else if (pick == 1) {
+            out += "\n";
+            return;
+        } else if (pick == 2) {
+            out += "Ask about ";
+            out += name;
+            out += "\n";
+            return;
+        }
+        
+        lineMix = static_cast<LineMix>(pick % 3);
+    }
+    
+    switch (lineMix) {
+        case LineMix::Short:
+            out += std::to_string(1 + nextRandom(state) % 99) + " " + name + ", $";
+            appendRandomPrice(out, state);
+            break;
+        case LineMix::Weighed: {
+            uint64_t shape = nextRandom(state) % 3;
+            
+            if (shape == 0) {
+                out += std::to_string(1 + nextRandom(state) % 5) + " lb. " + name + ", $";
+                appendRandomPrice(out, state);
+                out += "/lb.";
+            } else if (shape == 1) {
+                out += std::to_string(100 + nextRandom(state) % 900) + " g " + name + ", $";
+                appendRandomPrice(out, state);
+                out += "/kg";
+            } else {
+                out += std::to_string(1 + nextRandom(state) % 12) + " " + name + ", ";
+                out += std::to_string(2 + nextRandom(state) % 4) + "/$";
+                appendRandomPrice(out, state);
+            }
+            
+            break;
+        }
+        case LineMix::Long:
+        case LineMix::Mixed:
+            out += std::to_string(1 + nextRandom(state) % 6) + " " + name;
+            
+            for (int i = 0; i < 12; ++i) {
+                out += " ";
+                out += CORPUS_WORDS[nextRandom(state) % std::size(CORPUS_WORDS)];
+            }
+            
+            out += ", $";
+            appendRandomPrice(out, state);
+            break;
+    }
+    
+    out += "\n";
+}
+
+/**
+ * @brief Generates a shopping list for measurements.
+ * 
+ * @param lineMix The shape of the lines.
+ * @param lineCount The number of lines.
+ * @param seed The seed, so runs can be repeated exactly.
+ * @return The shopping list text.
+ */
+std::string generateCorpus(LineMix lineMix, size_t lineCount, uint64_t seed) {
+    std::string corpus;
+    uint64_t state = seed == 0 ? 0x9e3779b97f4a7c15ULL : seed;
+    
+    corpus.reserve(lineCount * (lineMix == LineMix::Long ? 110 : 32));
+    
+    for (size_t i = 0; i < lineCount; ++i) {
+        appendCorpusLine(corpus, lineMix, state);
+    }
+    
+    return corpus;
+}
+
+/**
+ * @brief Gets the name of a workload.
+ * 
+ * @param workload The workload.
+ * @return The name.
+ */
+std::string convertScalingWorkloadToString(ScalingWorkload workload) {
+    switch (workload) {
+        case ScalingWorkload::Parse:
+            return "parse";
+        case ScalingWorkload::AdaptiveParse:
+            return "adaptive";
+        case ScalingWorkload::Batch:
+            return "batch";
+        case ScalingWorkload::Aggregate:
+            return "aggregate";
+    }
+    
+    __builtin_unreachable();
+}
+
+/**
+ * @brief Gets the name of a line mix.
+ * 
+ * @param lineMix The line mix.
+ * @return The name.
+ */
+std::string convertLineMixToString(LineMix lineMix) {
+    switch (lineMix) {
+        case LineMix::Short:
+            return "short";
+        case LineMix::Weighed:
+            return "weighed";
+        case LineMix::Long:
+            return "long";
+        case LineMix::Mixed:
+            return "mixed";
+    }
+    
+    __builtin_unreachable();
+}
+
+/**
+ * @brief Converts seconds and microseconds from getrusage to seconds.
+ * 
+ * @param time The time.
+ * @return The time in seconds.
+ */
+double timevalToSeconds(const timeval &time) {
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) / 1e6;
+}
+
+/**
+ * @brief Runs a task in a child process and measures it.
+ * 
+ * Each measurement gets its own process so the peak resident memory belongs to that point alone,
+ * along with the inherited corpus, rather than to the largest point measured so far.
+ * 
+ * @tparam Task A function returning a checksum of its output.
+ * @param task The task.
+ * @return The measurement.
+ */
+template<typename Task>
+ChildMeasurement measureInChildProcess(const Task &task) {
+    int fds[2];
+    
+    if (::pipe(fds) != 0) {
+        throw std::runtime_error("Failed to create pipe");
+    }
+    
+    // Output buffered before the fork would otherwise be written twice.
+    std::cout.flush();
+    
+    pid_t pid = ::fork();
+    
+    if (pid < 0) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        throw std::runtime_error("Failed to fork");
+    }
+    
+    if (pid == 0) {
+        ::close(fds[0]);
+        
+        ChildMeasurement measurement = ChildMeasurement {};
+        rusage usageBefore;
+        rusage usageAfter;
+        
+        getrusage(RUSAGE_SELF, &usageBefore);
+        
+        auto t1 = std::chrono::steady_clock::now();
+        
+        try {
+            measurement.checksum = task();
+            measurement.isOk = true;
+        } catch (std::runtime_error& e) {
+            measurement.isOk = false;
+        }
+        
+        auto t2 = std::chrono::steady_clock::now();
+        
+        getrusage(RUSAGE_SELF, &usageAfter);
+        measurement.wallSeconds = std::chrono::duration<double>(t2 - t1).count();
+        measurement.cpuSeconds = timevalToSeconds(usageAfter.ru_utime) - timevalToSeconds(usageBefore.ru_utime);
+        measurement.cpuSeconds += timevalToSeconds(usageAfter.ru_stime) - timevalToSeconds(usageBefore.ru_stime);
+        measurement.maxRssKilobytes = usageAfter.ru_maxrss;
+        
+        try {
+            writeAll(fds[1], std::string_view(reinterpret_cast<const char *>(&measurement), sizeof(measurement)));
+        } catch (std::runtime_error& e) {
+            ::_exit(1);
+        }
+        
+        ::_exit(0);
+    }
+    
+    ::close(fds[1]);
+    
+    ChildMeasurement measurement = ChildMeasurement {};
+    size_t readCount = 0;
+    
+    while (readCount < sizeof(measurement)) {
+        ssize_t n = ::read(fds[0], reinterpret_cast<char *>(&measurement) + readCount, sizeof(measurement) - readCount);
+        
+        if (n <= 0) {
+            break;
+        }
+        
+        readCount += static_cast<size_t>(n);
+    }
+    
+    ::close(fds[0]);
+    
+    int status = 0;
+    
+    ::waitpid(pid, &status, 0);
+    
+    if (readCount != sizeof(measurement) || !measurement.isOk) {
+        throw std::runtime_error("Measurement failed");
+    }
+    
+    return measurement;
+}
+
+/**
+ * @brief Removes a directory and the files directly inside it.
+ * 
+ * @param directory The path to the directory.
+ */
+void removeDirectory(const std::string &directory) {
+    DIR *dir = ::opendir(directory.c_str());
+    
+    if (dir == nullptr) {
+        return;
+    }
+    
+    for (dirent *entry = ::readdir(dir); entry != nullptr; entry = ::readdir(dir)) {
+        std::string name = entry->d_name;
+        
+        if (name != "." && name != "..") {
+            ::unlink((directory + "/" + name).c_str());
+        }
+    }
+    
+    ::closedir(dir);
+    ::rmdir(directory.c_str());
+}
+
+/**
+ * @brief Writes a corpus to a new directory as files of about the same size.
+ * 
+ * @param corpus The shopping list text.
+ * @param fileSize The size of each file in bytes. Files are extended to the end of their last
+ * line.
+ * @param directory The directory to write to.
+ * @return The paths to the files.
+ */
+std::vector<std::string> writeCorpusFiles(const std::string_view &corpus, size_t fileSize, const std::string &directory) {
+    std::vector<std::string> filePaths;
+    
+    for (const std::string_view &fileContent : splitLineChunks(corpus, fileSize)) {
+        std::string filePath = directory + "/list-" + std::to_string(filePaths.size()) + ".txt";
+        int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open \"" + filePath + "\"");
+        }
+        
+        try {
+            writeAll(fd, fileContent);
+        } catch (std::runtime_error& e) {
+            ::close(fd);
+            throw;
+        }
+        
+        ::close(fd);
+        filePaths.push_back(std::move(filePath));
+    }
+    
+    return filePaths;
+}
+
+/**
+ * @brief Measures one workload at one point.
+ * 
+ * @param workload The workload.
+ * @param corpus The shopping list text.
+ * @param threadCount The number of threads.
+ * @param chunkSize The chunk size in bytes. Ignored by the adaptive workload.
+ * @param repetitionCount The number of times to measure.
+ * @return A measurement for every repetition.
+ */
+std::vector<ChildMeasurement> measureWorkload(ScalingWorkload workload, const std::string &corpus, size_t threadCount, size_t chunkSize, size_t repetitionCount) {
+    std::vector<ChildMeasurement> measurements;
+    
+    if (workload == ScalingWorkload::Parse) {
+        for (size_t repetition = 0; repetition < repetitionCount; ++repetition) {
+            measurements.push_back(measureInChildProcess([&]() {
+                ItemTable itemTable;
+                
+                return parseIntoItemTable(corpus, itemTable, threadCount, chunkSize);
+            }));
+        }
+    } else if (workload == ScalingWorkload::AdaptiveParse) {
+        for (size_t repetition = 0; repetition < repetitionCount; ++repetition) {
+            measurements.push_back(measureInChildProcess([&]() {
+                ItemTable itemTable;
+                
+                return parseIntoItemTableAdaptive(corpus, itemTable, threadCount);
+            }));
+        }
+    } else if (workload == ScalingWorkload::Aggregate) {
+        Query query = Query {
+            .filter = {},
+            .groupBy = GroupBy::Name,
+            .topCount = 10,
+        };
+        
+        for (size_t repetition = 0; repetition < repetitionCount; ++repetition) {
+            measurements.push_back(measureInChildProcess([&]() {
+                return runQueryOnText(query, corpus, threadCount, chunkSize).matchedCount;
+            }));
+        }
+    } else {
+        // The files are written before measuring so only the batch itself is timed.
+        const char *tmpDir = std::getenv("TMPDIR");
+        std::string directoryTemplate = std::string(tmpDir != nullptr ? tmpDir : "/tmp") + "/shopping-scaling-XXXXXX";
+        
+        if (::mkdtemp(directoryTemplate.data()) == nullptr) {
+            throw std::runtime_error("Failed to create a temporary directory");
+        }
+        
+        std::string directory = directoryTemplate;
+        std::string outputDirectory = directory + "/out";
+        
+        try {
+            std::vector<std::string> filePaths = writeCorpusFiles(corpus, chunkSize, directory);
+            
+            if (::mkdir(outputDirectory.c_str(), 0755) != 0) {
+                throw std::runtime_error("Failed to create \"" + outputDirectory + "\"");
+            }
+            
+            PartitionOptions partitionOptions = PartitionOptions {
+                .partitionFunction = makePartitionFunction(PartitionBy::Category),
+                .outputDirectory = outputDirectory,
+                .threadCount = threadCount,
+                .preferredUnit = Unit::Pound,
+                .format = PartitionFormat::Text,
+            };
+            
+            for (size_t repetition = 0; repetition < repetitionCount; ++repetition) {
+                measurements.push_back(measureInChildProcess([&]() {
+                    return static_cast<size_t>(runPartitionedBatch(filePaths, partitionOptions));
+                }));
+            }
+        } catch (std::runtime_error& e) {
+            removeDirectory(outputDirectory);
+            removeDirectory(directory);
+            throw;
+        }
+        
+        removeDirectory(outputDirectory);
+        removeDirectory(directory);
+    }
+    
+    return measurements;
+}
+
+/**
+ * @brief Formats a sample as a CSV row without a newline.
+ * 
+ * @param sample The sample.
+ * @return The row.
+ */
+std::string formatSampleCsv(const ScalingSample &sample) {
+    double megabytesPerSecond = sample.byteCount / 1e6 / sample.wallSeconds;
+    double linesPerSecond = sample.lineCount / sample.wallSeconds;
+    double cpuUtilization = sample.cpuSeconds / (sample.wallSeconds * sample.threadCount);
+    std::string chunkSizeStr = sample.chunkSize == 0 ? "adaptive" : std::to_string(sample.chunkSize);
+    char buffer[512];
+    int length = std::snprintf(
+        buffer,
+        sizeof(buffer),
+        "%s,%s,%zu,%zu,%zu,%s,%zu,%zu,%.6f,%.3f,%.1f,%.6f,%.4f,%lld",
+        convertScalingWorkloadToString(sample.workload).c_str(),
+        convertLineMixToString(sample.lineMix).c_str(),
+        sample.lineCount,
+        sample.byteCount,
+        sample.threadCount,
+        chunkSizeStr.c_str(),
+        sample.repetition,
+        sample.checksum,
+        sample.wallSeconds,
+        megabytesPerSecond,
+        linesPerSecond,
+        sample.cpuSeconds,
+        cpuUtilization,
+        static_cast<long long>(sample.maxRssKilobytes)
+    );
+    
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+/**
+ * @brief Formats samples as a JSON array of objects with the same fields as the CSV.
+ * 
+ * @param samples The samples.
+ * @return The JSON text.
+ */
+std::string formatSamplesJson(const std::vector<ScalingSample> &samples) {
+    std::vector<std::string_view> columns;
+    std::string_view header = SCALING_CSV_HEADER;
+    
+    for (size_t start = 0; start <= header.length();) {
+        size_t end = std::min(header.find(',', start), header.length());
+        
+        columns.push_back(header.substr(start, end - start));
+        start = end + 1;
+    }
+    
+    std::string out = "[\n";
+    
+    for (size_t i = 0; i < samples.size(); ++i) {
+        std::string row = formatSampleCsv(samples[i]);
+        std::string_view remaining = row;
+        
+        out += "  {";
+        
+        for (size_t column = 0; column < columns.size(); ++column) {
+            size_t end = std::min(remaining.find(','), remaining.length());
+            std::string_view value = remaining.substr(0, end);
+            
+            remaining = end < remaining.length() ? remaining.substr(end + 1) : std::string_view();
+            out += column == 0 ? "\"" : ", \"";
+            out.append(columns[column].data(), columns[column].length());
+            out += "\": ";
+            
+            // The workload and line mix are text, as is the chunk size of the adaptive workload.
+            if (column < 2 || value == "adaptive") {
+                out += "\"";
+                out.append(value.data(), value.length());
+                out += "\"";
+            } else {
+                out.append(value.data(), value.length());
+            }
+        }
+        
+        out += i + 1 < samples.size() ? "},\n" : "}\n";
+    }
+    
+    out += "]\n";
+    
+    return out;
+}
+
+/**
+ * @brief Writes text to a file, replacing it.
+ * 
+ * @param filePath The path to the file.
+ * @param content The text.
+ */
+void writeTextFile(const std::string &filePath, const std::string_view &content) {
+    int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open \"" + filePath + "\"");
+    }
+    
+    try {
+        writeAll(fd, content);
+    } catch (std::runtime_error& e) {
+        ::close(fd);
+        throw;
+    }
+    
+    ::close(fd);
+}
+
+/**
+ * @brief Measures every combination of the options and prints each sample as a CSV row.
+ * 
+ * Each corpus is generated once and shared by every point that uses it. Every repetition runs in
+ * its own child process, so results are not affected by memory left over from earlier points.
+ * The samples are also written to the CSV and JSON paths in the options, if given.
+ * 
+ * @param options The parameters to sweep.
+ * @return The samples.
+ */
+std::vector<ScalingSample> runScalingStudy(const ScalingOptions &options) {
+    std::vector<ScalingSample> samples;
+    std::string csv = std::string(SCALING_CSV_HEADER) + "\n";
+    
+    std::cout << SCALING_CSV_HEADER << std::endl;
+    
+    for (LineMix lineMix : options.lineMixes) {
+        for (size_t lineCount : options.lineCounts) {
+            std::string corpus = generateCorpus(lineMix, lineCount, 0x5eed + lineCount);
+            
+            for (ScalingWorkload workload : options.workloads) {
+                // The adaptive workload picks its own chunk size, so it is measured only once.
+                std::vector<size_t> chunkSizes = workload == ScalingWorkload::AdaptiveParse ? std::vector<size_t>{0} : options.chunkSizes;
+                
+                for (size_t threadCount : options.threadCounts) {
+                    for (size_t chunkSize : chunkSizes) {
+                        std::vector<ChildMeasurement> measurements = measureWorkload(workload, corpus, threadCount, chunkSize, options.repetitionCount);
+                        
+                        for (size_t repetition = 0; repetition < measurements.size(); ++repetition) {
+                            const ChildMeasurement &measurement = measurements[repetition];
+                            ScalingSample sample = ScalingSample {
+                                .workload = workload,
+                                .lineMix = lineMix,
+                                .lineCount = lineCount,
+                                .byteCount = corpus.length(),
+                                .threadCount = threadCount,
+                                .chunkSize = chunkSize,
+                                .repetition = repetition,
+                                .checksum = measurement.checksum,
+                                .wallSeconds = std::max(measurement.wallSeconds, 1e-9),
+                                .cpuSeconds = measurement.cpuSeconds,
+                                .maxRssKilobytes = measurement.maxRssKilobytes,
+                            };
+                            std::string row = formatSampleCsv(sample);
+                            
+                            std::cout << row << std::endl;
+                            csv += row + "\n";
+                            samples.push_back(sample);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    if (!options.csvPath.empty()) {
+        writeTextFile(options.csvPath, csv);
+    }
+    
+    if (!options.jsonPath.empty()) {
+        writeTextFile(options.jsonPath, formatSamplesJson(samples));
+    }
+    
+    return samples;
+}
+
+/**
+ * @brief Splits a comma-separated list.
+ * 
+ * @param s The list.
+ * @return The values, without empty ones.
+ */
+std::vector<std::string_view> splitList(const std::string_view &s) {
+    std::vector<std::string_view> values;
+    
+    for (size_t start = 0; start <= s.length();) {
+        size_t end = std::min(s.find(',', start), s.length());
+        
+        if (end > start) {
+            values.push_back(s.substr(start, end - start));
+        }
+        
+        start = end + 1;
+    }
+    
+    return values;
+}
+
+/**
+ * @brief Parses a list of sizes such as "64k,1m", where "k" and "m" multiply by 1024 and 1048576.
+ * 
+ * @param s The list.
+ * @return The sizes.
+ */
+std::vector<size_t> parseSizeList(const std::string_view &s) {
+    std::vector<size_t> sizes;
+    
+    for (std::string_view value : splitList(s)) {
+        size_t multiplier = 1;
+        
+        if (endsWithChar(value, 'k') || endsWithChar(value, 'K')) {
+            multiplier = 1 << 10;
+            value.remove_suffix(1);
+        } else if (endsWithChar(value, 'm') || endsWithChar(value, 'M')) {
+            multiplier = 1 << 20;
+            value.remove_suffix(1);
+        }
+        
+        std::optional<int64_t> sizeOpt = stringToIntStrict(value);
+        
+        if (!sizeOpt.has_value() || *sizeOpt < 1) {
+            throw std::runtime_error("Invalid size \"" + std::string(value) + "\"");
+        }
+        
+        sizes.push_back(static_cast<size_t>(*sizeOpt) * multiplier);
+    }
+    
+    return sizes;
+}
+
+/**
+ * @brief Runs a scaling study from command line options.
+ * 
+ * The options are "--workloads=parse,adaptive,batch,aggregate", "--threads=1,2,4", "--chunks=64k,1m",
+ * "--lines=100000", "--mix=short,weighed,long,mixed", "--repeat=3", "--csv=file" and
+ * "--json=file". Any that are left out sweep their defaults.
+ * 
+ * @param argc The number of arguments.
+ * @param argv The arguments, not including the program or mode.
+ * @return The exit code.
+ */
+int runScalingCli(int argc, char *argv[]) {
+    size_t hardwareThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    ScalingOptions options = ScalingOptions {
+        .workloads = {ScalingWorkload::Parse, ScalingWorkload::AdaptiveParse, ScalingWorkload::Batch, ScalingWorkload::Aggregate},
+        .threadCounts = {1, 2, 4},
+        .chunkSizes = {1 << 16, 1 << 18, 1 << 20},
+        .lineCounts = {100000, 1000000},
+        .lineMixes = {LineMix::Short, LineMix::Weighed, LineMix::Long, LineMix::Mixed},
+        .repetitionCount = 3,
+        .csvPath = "",
+        .jsonPath = "",
+    };
+    
+    if (hardwareThreadCount > 4) {
+        options.threadCounts.push_back(hardwareThreadCount);
+    }
+    
+    try {
+        for (int i = 0; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            if (startsWith(arg, "--workloads=")) {
+                options.workloads.clear();
+                
+                for (std::string_view value : splitList(std::string_view(arg).substr(12))) {
+                    if (value == "parse") {
+                        options.workloads.push_back(ScalingWorkload::Parse);
+                    } else if (value == "adaptive") {
+                        options.workloads.push_back(ScalingWorkload::AdaptiveParse);
+                    } else if (value == "batch") {
+                        options.workloads.push_back(ScalingWorkload::Batch);
+                    } else if (value == "aggregate") {
+                        options.workloads.push_back(ScalingWorkload::Aggregate);
+                    } else {
+                        throw std::runtime_error("Unknown workload \"" + std::string(value) + "\"");
+                    }
+                }
+            } else if (startsWith(arg, "--mix=")) {
+                options.lineMixes.clear();
+                
+                for (std::string_view value : splitList(std::string_view(arg).substr(6))) {
+                    if (value == "short") {
+                        options.lineMixes.push_back(LineMix::Short);
+                    } else if (value == "weighed") {
+                        options.lineMixes.push_back(LineMix::Weighed);
+                    } else if (value == "long") {
+                        options.lineMixes.push_back(LineMix::Long);
+                    } else if (value == "mixed") {
+                        options.lineMixes.push_back(LineMix::Mixed);
+                    } else {
+                        throw std::runtime_error("Unknown line mix \"" + std::string(value) + "\"");
+                    }
+                }
+            } else if (startsWith(arg, "--threads=")) {
+                options.threadCounts = parseSizeList(std::string_view(arg).substr(10));
+            } else if (startsWith(arg, "--chunks=")) {
+                options.chunkSizes = parseSizeList(std::string_view(arg).substr(9));
+            } else if (startsWith(arg, "--lines=")) {
+                options.lineCounts = parseSizeList(std::string_view(arg).substr(8));
+            } else if (startsWith(arg, "--repeat=")) {
+                std::vector<size_t> repetitionCounts = parseSizeList(std::string_view(arg).substr(9));
+                
+                options.repetitionCount = repetitionCounts.empty() ? 1 : repetitionCounts[0];
+            } else if (startsWith(arg, "--csv=")) {
+                options.csvPath = arg.substr(6);
+            } else if (startsWith(arg, "--json=")) {
+                options.jsonPath = arg.substr(7);
+            } else {
+                throw std::runtime_error("Unknown option \"" + arg + "\"");
+            }
+        }
+        
+        runScalingStudy(options);
+    } catch (std::runtime_error& e) {
+        std::cerr << "Scaling study failed: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file scaling.h
+ * @author Julia
+ * @brief Declares a harness that measures how the parallel paths scale across parameters.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef SCALING_H
+#define SCALING_H
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// A parallel path to measure.
+enum class ScalingWorkload {
+    /// Parsing text into an item table.
+    Parse,
+    /// Parsing text into an item table with the adaptive controller. The thread count is the most
+    /// workers it may use. It picks its own chunk size, so it is measured once per thread count.
+    AdaptiveParse,
+    /// Partitioned batch output over many files.
+    Batch,
+    /// Parsing text and grouping it by name in one pass.
+    Aggregate
+};
+
+/// The shape of the lines in a generated corpus.
+enum class LineMix {
+    /// Short counted items, e.g. "12 Milk, $3.49".
+    Short,
+    /// Weighed items and multi-buy prices, e.g. "2 lb. Chicken Breasts, $4.99/lb.".
+    Weighed,
+    /// Items with long names.
+    Long,
+    /// All of the above with section headers, blank lines and lines that fail to parse.
+    Mixed
+};
+
+/// The parameters to sweep. Every combination is measured.
+struct ScalingOptions {
+    /// The paths to measure.
+    std::vector<ScalingWorkload> workloads;
+    /// The numbers of threads.
+    std::vector<size_t> threadCounts;
+    /// The chunk sizes in bytes. For batch mode this is the size of each input file.
+    std::vector<size_t> chunkSizes;
+    /// The numbers of lines in the corpus.
+    std::vector<size_t> lineCounts;
+    /// The shapes of the lines in the corpus.
+    std::vector<LineMix> lineMixes;
+    /// The number of times each point is measured.
+    size_t repetitionCount;
+    /// The path to write CSV results to, or empty to skip.
+    std::string csvPath;
+    /// The path to write JSON results to, or empty to skip.
+    std::string jsonPath;
+};
+
+/// One measurement.
+struct ScalingSample {
+    /// The path that was measured.
+    ScalingWorkload workload;
+    /// The shape of the lines.
+    LineMix lineMix;
+    /// The number of lines in the corpus.
+    size_t lineCount;
+    /// The number of bytes in the corpus.
+    size_t byteCount;
+    /// The number of threads.
+    size_t threadCount;
+    /// The chunk size in bytes, or 0 for workloads that pick their own.
+    size_t chunkSize;
+    /// The repetition, starting at 0.
+    size_t repetition;
+    /// The items parsed or matched, or the total cents for batch mode, to check that runs did the
+    /// same work.
+    size_t checksum;
+    /// The elapsed time in seconds.
+    double wallSeconds;
+    /// The user and system CPU time in seconds.
+    double cpuSeconds;
+    /// The peak resident memory of the process that ran the measurement, in kilobytes.
+    int64_t maxRssKilobytes;
+};
+
+std::string generateCorpus(LineMix lineMix, size_t lineCount, uint64_t seed);
+std::vector<ScalingSample> runScalingStudy(const ScalingOptions &options);
+int runScalingCli(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file section.cpp
+ * @author Julia
+ * @brief Implements functions for section headers and per-section subtotals.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include "utils.h"
+#include "section.h"
+
+/// The longest header that is treated as a section name rather than a comment.
+size_t const MAX_SECTION_HEADER_LEN = 40;
+
+/**
+ * @brief Parses a section header comment, e.g. "// Produce".
+ * 
+ * A comment is a section header when its text is short and has no sentence punctuation, so notes
+ * such as "// Remember coupons." stay plain comments.
+ * 
+ * @param line The line.
+ * @return An optional containing the section name if the line is a section header.
+ */
+std::optional<std::string> parseSectionHeader(const std::string_view &line) {
+    if (!startsWith(line, "//")) {
+        return std::nullopt;
+    }
+    
+    std::string_view sView = line.substr(2);
+    
+    trimFromFront(sView);
+    trimFromBack(sView);
+    
+    if (sView.empty() || sView.length() > MAX_SECTION_HEADER_LEN) {
+        return std::nullopt;
+    }
+    
+    if (sView.find_first_of(".,:;!?/") != std::string_view::npos) {
+        return std::nullopt;
+    }
+    
+    return std::string(sView);
+}
+
+/**
+ * @brief Adds the price of an item to a section.
+ * 
+ * @param section The name of the section.
+ * @param priceCents The price of the item in cents.
+ */
+void SectionTotals::add(const std::string &section, int64_t priceCents) {
+    auto it = positions.find(section);
+    
+    if (it == positions.end()) {
+        it = positions.emplace(section, totals.size()).first;
+        totals.push_back(SectionTotal {
+            .name = section,
+            .totalPriceCents = 0,
+            .itemCount = 0,
+        });
+    }
+    
+    SectionTotal &sectionTotal = totals[it->second];
+    
+    sectionTotal.totalPriceCents += priceCents;
+    sectionTotal.itemCount++;
+}
+
+/**
+ * @brief Merges the subtotals of another file into these.
+ * 
+ * @param other The subtotals to merge.
+ */
+void SectionTotals::merge(const SectionTotals &other) {
+    for (const SectionTotal &otherTotal : other.totals) {
+        auto it = positions.find(otherTotal.name);
+        
+        if (it == positions.end()) {
+            positions.emplace(otherTotal.name, totals.size());
+            totals.push_back(otherTotal);
+            continue;
+        }
+        
+        totals[it->second].totalPriceCents += otherTotal.totalPriceCents;
+        totals[it->second].itemCount += otherTotal.itemCount;
+    }
+}
+
+/**
+ * @brief Gets the subtotals.
+ * 
+ * @return The subtotals in the order sections were first seen.
+ */
+const std::vector<SectionTotal> &SectionTotals::getTotals() const {
+    return totals;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file section.h
+ * @author Julia
+ * @brief Declares functions for section headers and per-section subtotals.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef SECTION_H
+#define SECTION_H
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+/// The subtotal of a section.
+struct SectionTotal {
+    /// The name of the section. Empty for items before the first header.
+    std::string name;
+    /// The total price of the items in the section in cents.
+    int64_t totalPriceCents;
+    /// The number of items in the section.
+    size_t itemCount;
+};
+
+/// Subtotals by section, kept in the order sections are first seen.
+class SectionTotals {
+public:
+    void add(const std::string &section, int64_t priceCents);
+    void merge(const SectionTotals &other);
+    const std::vector<SectionTotal> &getTotals() const;
+
+private:
+    /// The subtotals in the order they were first seen.
+    std::vector<SectionTotal> totals;
+    /// Maps section names to their position in totals.
+    std::unordered_map<std::string, size_t> positions;
+};
+
+std::optional<std::string> parseSectionHeader(const std::string_view &line);
+
+#endif
@@ -13,10 +13,28 @@
 #include <string_view>
 #include <cmath>
 #include <tuple>
+#include <string>
+#include <iterator>
+#include <vector>
+#include <stdexcept>
+#include <cctype>
 #include "unit.h"
 #include "utils.h"
 #include "shopping_list.h"
 
+/// Units that can follow the price, e.g. "$4.99 / lb". The longest match wins so "kg" is not read
+/// as "g".
+const std::string_view PER_UNIT_SUFFIXES[] = {"lbs", "lb", "oz", "g", "kg", "ea"};
+/// The count type for each of PER_UNIT_SUFFIXES.
+const CountType PER_UNIT_SUFFIX_COUNT_TYPES[] = {
+    CountType::Pound,
+    CountType::Pound,
+    CountType::Ounce,
+    CountType::Gram,
+    CountType::Kilogram,
+    CountType::Quantity,
+};
+
 /**
  * @brief Extracts the double from the front of the string.
  * 
@@ -26,43 +44,22 @@
  * @return The number.
  */
 double detectDoubleFromFront(std::string_view &sView) {
+    std::string_view rest = sView;
     // The length of the number string.
-    size_t numStrLen = 0;
-    size_t decimalCount = 0;
-    
-    // Extract the number string by looping through the beginning of the string until a 
-    // non-number is found.
-    for (size_t i = 0; i < sView.length();) {
-        char c = sView[i];
-        size_t charLen = getCharLen(c);
-        
-        if (charLen != 1) {
-            // Not a valid number
-            throw std::runtime_error("Expected string to start with a number");
-        }
+    size_t numStrLen = skipDigits(rest);
+    
+    if (numStrLen == 0) {
+        // Not a digit so we can assume that the string does not start with a number.
+        throw std::runtime_error("Expected string to start with a number");
+    }
+    
+    if (startsWithChar(rest, '.')) {
+        rest.remove_prefix(1);
+        numStrLen += 1 + skipDigits(rest);
         
-        // Check if the character is a digit.
-        if (std::isdigit(c)) {
-            numStrLen += charLen;
-        } else if (c == '.') {
-            if (decimalCount > 0) {
-                throw std::runtime_error("Too many decimal places in number string");
-            } else if (numStrLen == 0) {
-                throw std::runtime_error("Expected string to start with a number");
-            }
-            
-            decimalCount++;
-            numStrLen += charLen;
-        } else if (numStrLen == 0) {
-            // Not a digit and no digits have been found yet so we can assume that the string does 
-            // not start with a number.
-            throw std::runtime_error("Expected string to start with a number");
-        } else {
-            // The number string has ended.
-            break;
+        if (startsWithChar(rest, '.')) {
+            throw std::runtime_error("Too many decimal places in number string");
         }
-        
-        i += charLen;
     }
     
     // Get the number string.
@@ -93,58 +90,31 @@ double detectDoubleFromFront(std::string_view &sView) {
  * fractional number.
  */
 std::tuple<size_t, size_t, size_t> detectDecimalFromBack(std::string_view &sView) {
-    size_t fractionalLength = 0;
-    size_t wholeLength = 0;
-    size_t decimalCount = 0;
-    
-    // Extract the price string by looping through the end of the string until a non-number is found.
-    for (size_t i = sView.length() - 1; i < sView.length();) {
-        char c = sView[i];
-        size_t charLen = getCharLen(c);
-        
-        if (charLen != 1) {
-            // Not a valid number
-            throw std::runtime_error("Expected string to end with a number");
-        }
-        
-        // Check if the character is a digit.
-        if (std::isdigit(c)) {
-            if (decimalCount == 0) {
-                fractionalLength += charLen;
-            } else if (decimalCount == 1) {
-                wholeLength += charLen;
-            } else {
-                throw std::runtime_error("Too many decimal places in price string");
-            }
-        } else if (c == '.') {
-            if (decimalCount > 0) {
-                throw std::runtime_error("Too many decimal places in price string");
-            } else if (fractionalLength == 0) {
-                throw std::runtime_error("Expected string to end with a number");
-            }
-            
-            decimalCount++;
-        } else if (fractionalLength == 0) {
-            // Not a digit and no digits have been found yet so we can assume that the string does 
-            // not end with a number.
-            throw std::runtime_error("Expected string to end with a number");
-        } else {
-            // The price string has ended.
-            break;
-        }
-        
-        // Advance backwards.
-        i -= charLen;
-    }
+    size_t fractionalLength = countTrailingDigits(sView);
     
     if (fractionalLength == 0) {
         throw std::runtime_error("Expected string to end with a number");
     }
     
+    std::string_view beforeFractional = std::string_view(sView.data(), sView.length() - fractionalLength);
+    
+    if (!endsWithChar(beforeFractional, '.')) {
+        // A whole number with no decimal point.
+        throw std::runtime_error("Expected string to end with a number");
+    }
+    
+    beforeFractional.remove_suffix(1);
+    
+    size_t wholeLength = countTrailingDigits(beforeFractional);
+    
     if (wholeLength == 0) {
         throw std::runtime_error("Expected string to end with a number");
     }
     
+    if (endsWithChar(std::string_view(beforeFractional.data(), beforeFractional.length() - wholeLength), '.')) {
+        throw std::runtime_error("Too many decimal places in price string");
+    }
+    
     std::string_view fractionalStrView = std::string_view(sView.data() + sView.length() - fractionalLength, fractionalLength);
     
     // Remove the fractional and the period from the string view.
@@ -180,33 +150,10 @@ std::tuple<size_t, size_t, size_t> detectDecimalFromBack(std::string_view &sView
  * @brief Detects an integer from the back of the string.
  * 
  * @param sView The string view to check.
- * @return The integer.
+ * @return The length of the integer.
  */
 size_t detectIntFromBack(const std::string_view &sView) {
-    size_t intLen = 0;
-    
-    // Extract the price string by looping through the end of the string until a non-number is found.
-    for (size_t i = sView.length() - 1; i < sView.length();) {
-        char c = sView[i];
-        size_t charLen = getCharLen(c);
-        
-        if (charLen != 1) {
-            // Not a valid number
-            throw std::runtime_error("Expected string to end with a number");
-        }
-        
-        // Check if the character is a digit.
-        if (std::isdigit(c)) {
-            intLen += charLen;
-        }  else {
-            // The unit string has ended.
-            break;
-        }
-        
-        i -= charLen;
-    }
-    
-    return intLen;
+    return countTrailingDigits(sView);
 }
 
 /**
@@ -218,29 +165,8 @@ size_t detectIntFromBack(const std::string_view &sView) {
  * @return An optional containing the integer if it exists.
  */
 std::optional<int64_t> tryExtractIntFromBack(std::string_view &sView) {
-    size_t numStrLength = 0;
-    
-    // Extract the count of the price per unit by looping through the end of the string until a 
-    // non-number is found. We only expect a whole number.
-    for (size_t i = sView.length() - 1; i < sView.length();) {
-        char c = sView[i];
-        size_t charLen = getCharLen(c);
-        
-        if (charLen != 1) {
-            // Not a valid number
-            throw std::runtime_error("Expected string to end with a number");
-        }
-        
-        // Check if the character is a digit.
-        if (std::isdigit(c)) {
-            numStrLength += charLen;
-        }  else {
-            // The unit string has ended.
-            break;
-        }
-        
-        i -= charLen;
-    }
+    // We only expect a whole number.
+    size_t numStrLength = countTrailingDigits(sView);
     
     // If this is 0 there is no number.
     if (numStrLength == 0) {
@@ -317,16 +243,41 @@ int64_t getShoppingListItemTotalPrice(const ShoppingListItem &shoppingListItem)
     return priceCents;
 }
 
-#include <iostream>
+/**
+ * @brief Get the normalized unit price of a shopping list item.
+ * 
+ * Weighed items are priced per one of the preferred unit and counted items are priced per item, so
+ * that prices for the same item can be compared across lists.
+ * 
+ * @param shoppingListItem The shopping list item.
+ * @param preferredUnit The unit to price weighed items in.
+ * @return The price in cents per unit.
+ */
+double getShoppingListItemUnitPrice(const ShoppingListItem &shoppingListItem, Unit preferredUnit) {
+    double priceCents = static_cast<double>(shoppingListItem.priceCentsPerUnit);
+    double perUnitCount = static_cast<double>(shoppingListItem.perUnitCount);
+    std::optional<Unit> perUnitUnitOpt = convertCountTypeToUnit(shoppingListItem.perUnitCountType);
+    
+    if (perUnitUnitOpt.has_value()) {
+        // Convert the per unit weight to the preferred unit.
+        perUnitCount = convertWeight(perUnitCount, *perUnitUnitOpt, preferredUnit);
+    }
+    
+    if (perUnitCount <= 0) {
+        return priceCents;
+    }
+    
+    return priceCents / perUnitCount;
+}
 
 /**
- * @brief Parse a shopping list item string.
+ * @brief Parse a shopping list item string without copying its name.
  * 
  * @param s The shopping list item string.
- * @return The shopping list item.
+ * @return The shopping list item, with a name that points into the string.
  */
-ShoppingListItem parseShoppingListItemStr(const std::string &s) {
-    std::string_view sView = std::string_view(s.data(), s.length());
+ShoppingListItemView parseShoppingListItemView(const std::string_view &s) {
+    std::string_view sView = s;
     
     // Get the unit count type.
     CountType perUnitCountType;
@@ -337,24 +288,11 @@ ShoppingListItem parseShoppingListItemStr(const std::string &s) {
         sView = std::string_view(sView.data(), sView.length() - 1);
     }
     
-    if (endsWith(sView, "lbs")) {
-        sView = std::string_view(sView.data(), sView.length() - 3);
-        perUnitCountType = CountType::Pound;
-    } else if (endsWith(sView, "lb")) {
-        sView = std::string_view(sView.data(), sView.length() - 2);
-        perUnitCountType = CountType::Pound;
-    } else if (endsWith(sView, "oz")) {
-        sView = std::string_view(sView.data(), sView.length() - 2);
-        perUnitCountType = CountType::Ounce;
-    } else if (endsWith(sView, "g")) {
-        sView = std::string_view(sView.data(), sView.length() - 1);
-        perUnitCountType = CountType::Gram;
-    } else if (endsWith(sView, "kg")) {
-        sView = std::string_view(sView.data(), sView.length() - 2);
-        perUnitCountType = CountType::Kilogram;
-    }  else if (endsWith(sView, "ea")) {
-        sView = std::string_view(sView.data(), sView.length() - 2);
-        perUnitCountType = CountType::Quantity;
+    std::optional<size_t> suffixOpt = matchSuffix(sView, PER_UNIT_SUFFIXES, std::size(PER_UNIT_SUFFIXES));
+    
+    if (suffixOpt.has_value()) {
+        sView.remove_suffix(PER_UNIT_SUFFIXES[*suffixOpt].length());
+        perUnitCountType = PER_UNIT_SUFFIX_COUNT_TYPES[*suffixOpt];
     } else {
         hasPerUnitCountType = false;
         // Assume it's a quantity.
@@ -424,7 +362,7 @@ ShoppingListItem parseShoppingListItemStr(const std::string &s) {
         } else {
             throw std::runtime_error("Expected unit count before price");
         }
-    
+        
         // Trim whitespaces from the back.
         trimFromBack(sView);
     }
@@ -495,19 +433,67 @@ ShoppingListItem parseShoppingListItemStr(const std::string &s) {
         }
     }
     
+    return ShoppingListItemView {
+        .name = sView,
+        .priceCentsPerUnit = priceCentsPerUnit,
+        .count = count,
+        .countType = countType,
+        .perUnitCount = perUnitCount,
+        .perUnitCountType = perUnitCountType,
+    };
+}
+
+/**
+ * @brief Parse a shopping list item string.
+ * 
+ * @param s The shopping list item string.
+ * @return The shopping list item.
+ */
+ShoppingListItem parseShoppingListItemStr(const std::string &s) {
+    ShoppingListItemView itemView = parseShoppingListItemView(s);
+    
     // This should allocate.
     // 
     // It's not necessary to put the string view into a string but it makes the shopping list 
     // item more predictable, as the string view could be invalidated if the original string is
     // modified or dropped from memory.
-    std::string name = std::string(sView.data(), sView.length());
-    
     return ShoppingListItem {
-        .name = name,
-        .priceCentsPerUnit = priceCentsPerUnit,
-        .count = count,
-        .countType = countType,
-        .perUnitCount = perUnitCount,
-        .perUnitCountType = perUnitCountType,
+        .name = std::string(itemView.name),
+        .priceCentsPerUnit = itemView.priceCentsPerUnit,
+        .count = itemView.count,
+        .countType = itemView.countType,
+        .perUnitCount = itemView.perUnitCount,
+        .perUnitCountType = itemView.perUnitCountType,
     };
 }
+
+/**
+ * @brief Normalizes an item name so the same item written differently compares equal.
+ * 
+ * Trims the name, collapses runs of whitespace to a single space and lowercases ASCII letters.
+ * 
+ * @param name The name of the item.
+ * @return The normalized name.
+ */
+std::string normalizeItemName(const std::string_view &name) {
+    std::string normalized;
+    bool isPendingSpace = false;
+    
+    normalized.reserve(name.length());
+    
+    for (char c : name) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            isPendingSpace = !normalized.empty();
+            continue;
+        }
+        
+        if (isPendingSpace) {
+            normalized += ' ';
+            isPendingSpace = false;
+        }
+        
+        normalized += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    
+    return normalized;
+}
@@ -17,6 +17,8 @@
 #include <string_view>
 #include <cmath>
 #include <tuple>
+#include <string>
+#include <vector>
 #include "unit.h"
 #include "utils.h"
 
@@ -36,7 +38,27 @@ struct ShoppingListItem {
     CountType perUnitCountType;
 };
 
+/// A parsed shopping list item whose name points into the parsed text, so nothing is copied.
+struct ShoppingListItemView {
+    /// The name of the item. Only valid while the parsed text is.
+    std::string_view name;
+    /// The price of the item in cents, per unit.
+    int64_t priceCentsPerUnit;
+    /// The count of the item.
+    double count;
+    /// The type of count for the item.
+    CountType countType;
+    /// The count of the per unit.
+    int64_t perUnitCount;
+    /// The type of count for the price per unit.
+    CountType perUnitCountType;
+};
+
+ShoppingListItemView parseShoppingListItemView(const std::string_view &s);
 ShoppingListItem parseShoppingListItemStr(const std::string &s);
 int64_t getShoppingListItemTotalPrice(const ShoppingListItem &shoppingListItem);
+double getShoppingListItemUnitPrice(const ShoppingListItem &shoppingListItem, Unit preferredUnit);
+std::vector<ShoppingListItem> readShoppingListFromFile(const std::string &filePath);
+std::string normalizeItemName(const std::string_view &name);
 
 #endif
\ No newline at end of file
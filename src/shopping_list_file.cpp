@@ -0,0 +1,57 @@
+/**
+ * @file shopping_list_file.cpp
+ * @author Julia
+ * @brief Reads shopping lists from files.
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * Kept apart from shopping_list.cpp, which only parses, so the lean program links no <iostream>.
+ * 
+ * @copyright Copyright (c) 2026
+ */
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "utils.h"
+#include "shopping_list.h"
+
+/**
+ * @brief Reads a shopping list from a file.
+ * 
+ * @param filePath The path to the shopping list file.
+ * @return The shopping list items.
+ */
+std::vector<ShoppingListItem> readShoppingListFromFile(const std::string &filePath) {
+    std::ifstream file(filePath);
+    
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file.");
+    }
+    
+    std::vector<ShoppingListItem> shoppingListItems;
+    
+    for (std::string line; getline(file, line);) {
+        // Skip empty lines.
+        if (line.empty()) {
+            continue;
+        }
+        
+        if (startsWith(line, "//")) {
+            // Skip comments.
+            continue;
+        }
+        
+        try {
+            ShoppingListItem shoppingListItem = parseShoppingListItemStr(line);
+            shoppingListItems.push_back(shoppingListItem);
+        } catch (std::runtime_error& e) {
+            std::cerr << "Failed to parse line \"" << line << "\": " << e.what() << "; ignoring" << std::endl;
+            // Ignore errors and continue to the next line.
+        }
+    }
+    
+    return shoppingListItems;
+}
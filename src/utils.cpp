@@ -13,6 +13,13 @@
 #include <string_view>
 #include <charconv>
 #include <cmath>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /**
  * @brief Checks if a number is a whole number.
@@ -65,7 +72,7 @@ bool endsWith(const std::string_view& fullString, const std::string_view& ending
  * @return True if the string starts with the character, false otherwise.
  */
 bool startsWithChar(const std::string_view& fullString, const char start) {
-    return fullString[0] == start;
+    return !fullString.empty() && fullString[0] == start;
 }
 
 /**
@@ -76,37 +83,272 @@ bool startsWithChar(const std::string_view& fullString, const char start) {
  * @return True if the string ends with the character, false otherwise.
  */
 bool endsWithChar(const std::string_view& fullString, const char end) {
-    return fullString[fullString.length() - 1] == end;
+    return !fullString.empty() && fullString[fullString.length() - 1] == end;
 }
 
+/// Classes of characters that can be scanned for.
+enum class CharClass {
+    /// Whitespace as classified by std::isspace in the C locale.
+    Whitespace,
+    /// The digits 0-9.
+    Digit
+};
+
 /**
- * @brief Trims whitespace from the front of a string.
+ * @brief Builds a lookup table for a class of characters.
  * 
- * Advances the start of the string until a non-whitespace character is found.
+ * @param charClass The class of characters.
+ * @return A table with true for every byte in the class.
+ */
+constexpr std::array<bool, 256> makeCharClassTable(CharClass charClass) {
+    std::array<bool, 256> table = {};
+    
+    for (int c = 0; c < 256; ++c) {
+        if (charClass == CharClass::Whitespace) {
+            table[c] = c == ' ' || (c >= '\t' && c <= '\r');
+        } else {
+            table[c] = c >= '0' && c <= '9';
+        }
+    }
+    
+    return table;
+}
+
+/// Lookup table for whitespace.
+constexpr std::array<bool, 256> WHITESPACE_TABLE = makeCharClassTable(CharClass::Whitespace);
+/// Lookup table for digits.
+constexpr std::array<bool, 256> DIGIT_TABLE = makeCharClassTable(CharClass::Digit);
+
+/**
+ * @brief Checks if a byte is in a class of characters.
  * 
- * @param str The string to trim.
- * @return True if the string was trimmed, false otherwise.
+ * @tparam charClass The class of characters.
+ * @param c The byte.
+ * @return True if the byte is in the class, false otherwise.
  */
-bool trimFromFront(std::string_view &sView) {
-    if (sView.empty()) {
-        return false;
+template<CharClass charClass>
+inline bool isInCharClass(const char c) {
+    if constexpr (charClass == CharClass::Whitespace) {
+        return WHITESPACE_TABLE[static_cast<unsigned char>(c)];
+    } else {
+        return DIGIT_TABLE[static_cast<unsigned char>(c)];
+    }
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Classifies 16 bytes at once.
+ * 
+ * @tparam charClass The class of characters.
+ * @param chunk The bytes.
+ * @return A mask with a bit set for every byte in the class.
+ */
+template<CharClass charClass>
+inline uint32_t getCharClassMask(const __m128i chunk) {
+    if constexpr (charClass == CharClass::Whitespace) {
+        // '\t' to '\r' are contiguous, so one unsigned range check covers them.
+        __m128i isSpace = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '));
+        __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+        __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+        
+        return _mm_movemask_epi8(_mm_or_si128(isSpace, isControl));
+    } else {
+        __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(9)), shifted);
+        
+        return _mm_movemask_epi8(isDigit);
+    }
+}
+#endif
+
+/**
+ * @brief Counts the characters of a class at the front of a string.
+ * 
+ * @tparam charClass The class of characters.
+ * @param sView The string.
+ * @return The number of leading characters in the class.
+ */
+template<CharClass charClass>
+size_t countLeading(const std::string_view &sView) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // Check 16 bytes at a time until one is outside the class.
+    for (; i + 16 <= sView.length(); i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sView.data() + i));
+        uint32_t outsideMask = ~getCharClassMask<charClass>(chunk) & 0xffff;
+        
+        if (outsideMask != 0) {
+            return i + __builtin_ctz(outsideMask);
+        }
+    }
+#endif
+
+    while (i < sView.length() && isInCharClass<charClass>(sView[i])) {
+        i++;
+    }
+    
+    return i;
+}
+
+/**
+ * @brief Counts the characters of a class at the back of a string.
+ * 
+ * @tparam charClass The class of characters.
+ * @param sView The string.
+ * @return The number of trailing characters in the class.
+ */
+template<CharClass charClass>
+size_t countTrailing(const std::string_view &sView) {
+    size_t count = 0;
+
+#if defined(__SSE2__)
+    // Check 16 bytes at a time from the back until one is outside the class.
+    for (; count + 16 <= sView.length(); count += 16) {
+        const char *chunkStart = sView.data() + sView.length() - count - 16;
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(chunkStart));
+        uint32_t outsideMask = ~getCharClassMask<charClass>(chunk) & 0xffff;
+        
+        if (outsideMask != 0) {
+            // The highest bit outside the class is the last byte that stops the run.
+            return count + __builtin_clz(outsideMask) - 16;
+        }
     }
+#endif
+
+    while (count < sView.length() && isInCharClass<charClass>(sView[sView.length() - count - 1])) {
+        count++;
+    }
+    
+    return count;
+}
+
+/**
+ * @brief Counts the whitespace characters at the front of a string.
+ * 
+ * @param sView The string.
+ * @return The number of leading whitespace characters.
+ */
+size_t countLeadingWhitespace(const std::string_view &sView) {
+    return countLeading<CharClass::Whitespace>(sView);
+}
+
+/**
+ * @brief Counts the whitespace characters at the back of a string.
+ * 
+ * @param sView The string.
+ * @return The number of trailing whitespace characters.
+ */
+size_t countTrailingWhitespace(const std::string_view &sView) {
+    return countTrailing<CharClass::Whitespace>(sView);
+}
+
+/**
+ * @brief Counts the digits at the front of a string.
+ * 
+ * @param sView The string.
+ * @return The number of leading digits.
+ */
+size_t countLeadingDigits(const std::string_view &sView) {
+    return countLeading<CharClass::Digit>(sView);
+}
+
+/**
+ * @brief Counts the digits at the back of a string.
+ * 
+ * @param sView The string.
+ * @return The number of trailing digits.
+ */
+size_t countTrailingDigits(const std::string_view &sView) {
+    return countTrailing<CharClass::Digit>(sView);
+}
+
+/**
+ * @brief Advances a string past the digits at its front.
+ * 
+ * @param sView The string view to advance.
+ * @return The number of digits skipped.
+ */
+size_t skipDigits(std::string_view &sView) {
+    size_t digitCount = countLeadingDigits(sView);
     
-    size_t start = 0;
-    size_t originalStart = start;
+    sView.remove_prefix(digitCount);
     
-    while (start < sView.length() && std::isspace(sView[start])) {
-        start++;
+    return digitCount;
+}
+
+/**
+ * @brief Finds the last character in a string that is one of a set of characters.
+ * 
+ * @param sView The string to search.
+ * @param charSet The set of characters.
+ * @return The position of the character, or std::string_view::npos if there is none.
+ */
+size_t findLastOfSet(const std::string_view &sView, const std::string_view &charSet) {
+    // One bit per byte value.
+    uint64_t table[4] = {0, 0, 0, 0};
+    
+    for (char c : charSet) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        
+        table[byte / 64] |= 1ULL << (byte % 64);
     }
     
-    // Get the difference between the original start and the new start so we can trim the string.
-    size_t difference = start;
+    for (size_t i = sView.length(); i > 0; --i) {
+        unsigned char byte = static_cast<unsigned char>(sView[i - 1]);
+        
+        if (table[byte / 64] & (1ULL << (byte % 64))) {
+            return i - 1;
+        }
+    }
     
-    if (difference == 0) {
+    return std::string_view::npos;
+}
+
+/**
+ * @brief Finds the longest of a set of suffixes that a string ends with.
+ * 
+ * @param sView The string to check.
+ * @param suffixes The suffixes.
+ * @param suffixCount The number of suffixes.
+ * @return An optional containing the index of the longest matching suffix.
+ */
+std::optional<size_t> matchSuffix(const std::string_view &sView, const std::string_view *suffixes, size_t suffixCount) {
+    std::optional<size_t> bestIndex = std::nullopt;
+    size_t bestLength = 0;
+    
+    for (size_t i = 0; i < suffixCount; ++i) {
+        const std::string_view &suffix = suffixes[i];
+        
+        if (suffix.length() > sView.length() || (bestIndex.has_value() && suffix.length() <= bestLength)) {
+            continue;
+        }
+        
+        if (sView.compare(sView.length() - suffix.length(), suffix.length(), suffix) == 0) {
+            bestIndex = i;
+            bestLength = suffix.length();
+        }
+    }
+    
+    return bestIndex;
+}
+
+/**
+ * @brief Trims whitespace from the front of a string.
+ * 
+ * Advances the start of the string until a non-whitespace character is found.
+ * 
+ * @param str The string to trim.
+ * @return True if the string was trimmed, false otherwise.
+ */
+bool trimFromFront(std::string_view &sView) {
+    size_t start = countLeadingWhitespace(sView);
+    
+    if (start == 0) {
         return false;
     }
     
-    sView = std::string_view(sView.data() + start, sView.length() - start);
+    sView.remove_prefix(start);
     
     // Return true if the string was trimmed
     return true;
@@ -115,31 +357,20 @@ bool trimFromFront(std::string_view &sView) {
 /**
  * @brief Trims whitespace from the back of a string.
  * 
- * Advances the end of the string until a non-whitespace character is found.
+ * Advances the end of the string until a non-whitespace character is found. A string that is all
+ * whitespace is trimmed to an empty string.
  * 
  * @param str The string to trim.
  * @return True if the string was trimmed, false otherwise.
  */
 bool trimFromBack(std::string_view &sView) {
-    if (sView.empty()) {
-        return false;
-    }
-    
-    size_t end = sView.length() - 1;
-    size_t originalEnd = end;
-    
-    while (end > 0 && std::isspace(sView[end])) {
-        end--;
-    }
-    
-    // Get the difference between the original end and the new end so we can trim the string.
-    size_t difference = originalEnd - end;
+    size_t difference = countTrailingWhitespace(sView);
     
     if (difference == 0) {
         return false;
     }
     
-    sView = std::string_view(sView.data(), sView.length() - difference);
+    sView.remove_suffix(difference);
     
     // Return true if the string was trimmed
     return true;
@@ -191,7 +422,24 @@ double toPrecision(const double num, const int precision) {
  * @return The double value of the string.
  */
 std::optional<double> stringToDouble(const std::string_view& s) {
-    return std::atof(s.data());
+    // Copy the view so that characters after it are never read as part of the number.
+    char buffer[64];
+    
+    if (s.empty() || s.length() >= sizeof(buffer)) {
+        return std::nullopt;
+    }
+    
+    std::memcpy(buffer, s.data(), s.length());
+    buffer[s.length()] = '\0';
+    
+    char *end = nullptr;
+    double value = std::strtod(buffer, &end);
+    
+    if (end == buffer) {
+        return std::nullopt;
+    }
+    
+    return value;
 }
 
 /**
@@ -201,5 +449,62 @@ std::optional<double> stringToDouble(const std::string_view& s) {
  * @return The integer value of the string.
  */
 std::optional<int64_t> stringToInt(const std::string_view& s) {
-    return std::atoi(s.data());
+    int64_t value = 0;
+    auto [end, error] = std::from_chars(s.data(), s.data() + s.length(), value);
+    
+    // Only the digits within the view are read.
+    if (error != std::errc() || end == s.data()) {
+        return std::nullopt;
+    }
+    
+    return value;
+}
+
+/**
+ * @brief Converts a string that is only an integer to an integer.
+ * 
+ * Unlike stringToInt, which reads the number at the start of the string, anything after the
+ * number is an error, so option values such as "3abc" are rejected.
+ * 
+ * @param s The string.
+ * @return The integer value of the string, or nothing if the string is not exactly an integer.
+ */
+std::optional<int64_t> stringToIntStrict(const std::string_view& s) {
+    int64_t value = 0;
+    auto [end, error] = std::from_chars(s.data(), s.data() + s.length(), value);
+    
+    if (error != std::errc() || end == s.data() || end != s.data() + s.length()) {
+        return std::nullopt;
+    }
+    
+    return value;
+}
+
+/**
+ * @brief Continues a 64-bit FNV-1a hash with more bytes.
+ * 
+ * The hash of a string followed by s is hashString(s, hashString(string)), so a hash of a growing
+ * file can be extended without reading it again.
+ * 
+ * @param s The bytes to add.
+ * @param hash The hash of the bytes before s.
+ * @return The hash of the bytes before s followed by s.
+ */
+uint64_t hashString(const std::string_view& s, uint64_t hash) {
+    for (char c : s) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    
+    return hash;
+}
+
+/**
+ * @brief Hashes a string using 64-bit FNV-1a.
+ * 
+ * @param s The string.
+ * @return The hash of the string.
+ */
+uint64_t hashString(const std::string_view& s) {
+    return hashString(s, 14695981039346656037ULL);
 }
@@ -25,10 +25,20 @@ bool startsWithChar(const std::string_view& fullString, const char start);
 bool endsWithChar(const std::string_view& fullString, const char end);
 bool trimFromFront(std::string_view& sView);
 bool trimFromBack(std::string_view& sView);
+size_t countLeadingWhitespace(const std::string_view& sView);
+size_t countTrailingWhitespace(const std::string_view& sView);
+size_t countLeadingDigits(const std::string_view& sView);
+size_t countTrailingDigits(const std::string_view& sView);
+size_t skipDigits(std::string_view& sView);
+size_t findLastOfSet(const std::string_view& sView, const std::string_view& charSet);
+std::optional<size_t> matchSuffix(const std::string_view& sView, const std::string_view* suffixes, size_t suffixCount);
 size_t getCharLen(const char c);
 double centsToDollars(const int64_t cents);
 double toPrecision(const double num, const int precision);
 std::optional<double> stringToDouble(const std::string_view& s);
 std::optional<int64_t> stringToInt(const std::string_view& s);
+std::optional<int64_t> stringToIntStrict(const std::string_view& s);
+uint64_t hashString(const std::string_view& s);
+uint64_t hashString(const std::string_view& s, uint64_t hash);
 
 #endif